@@ -0,0 +1,230 @@
+#==================================================================================================
+#
+#  Zero-overhead codegen check for the C++ Training
+#
+#  Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+#
+#  This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+#  context of the C++ training or with explicit agreement by Klaus Iglberger.
+#
+#==================================================================================================
+#
+#  Usage: cmake -DCOMPILER=<c++> -DSTANDARD=<c++20> -DOPTIMIZATION=<-O2> -DSOURCE=<file.cpp>
+#               -DOUTPUT=<file.s> -P CheckCodegen.cmake
+#
+#  Compiles the given source file to assembly and compares every function 'raw::<name>()' to
+#  the according function 'strong::<name>()'. The instruction streams of both functions are
+#  normalized (directives, comments and names of local labels are removed, but GCC's constants
+#  '.LC<N>' keep their names since equal constants share one name) and have to be identical,
+#  i.e. the strong type must not add a single instruction or change a constant. The only
+#  accepted difference is a consistent renaming of the scratch registers: both streams are
+#  compared after replacing every register by the order of its first use (per register class,
+#  with sub-registers such as '%r10d' mapped to the full register). The registers of the calling
+#  convention (arguments, return value, stack and instruction pointer) keep their names, i.e.
+#  swapped operands or a general purpose register in place of a vector register are still
+#  detected. The operands of a comparison for equality are compared in sorted order. Function
+#  names must consist of lowercase letters and underscores only and must not be overloaded.
+#
+#  A source file can opt out (e.g. if the compiler doesn't support the required language
+#  features) by means of '#pragma message( "CODEGEN SKIPPED: <reason>" )'. Known deviations in
+#  the block layout (i.e. the order of the basic blocks and the duplication of blocks chosen by
+#  the compiler's branch heuristics) are declared per function by means of
+#  '#pragma message( "CODEGEN LAYOUT: <name>..." )'. Both streams of such a function must still
+#  consist of the same instructions, apart from jumps and returns and independent of their order
+#  and number of occurrences.
+#
+#==================================================================================================
+
+cmake_minimum_required(VERSION 3.10 FATAL_ERROR)
+
+foreach(variable COMPILER STANDARD OPTIMIZATION SOURCE OUTPUT)
+   if(NOT DEFINED ${variable})
+      message(FATAL_ERROR "CheckCodegen: '${variable}' is not defined")
+   endif()
+endforeach()
+
+execute_process(
+   COMMAND ${COMPILER} -std=${STANDARD} ${OPTIMIZATION} -S -fno-asynchronous-unwind-tables
+           -o ${OUTPUT} ${SOURCE}
+   RESULT_VARIABLE result
+   OUTPUT_VARIABLE output
+   ERROR_VARIABLE output
+   )
+
+if(NOT result EQUAL 0)
+   message(FATAL_ERROR "CheckCodegen: compilation of '${SOURCE}' failed:\n${output}")
+endif()
+
+if(output MATCHES "CODEGEN SKIPPED: ([^'\n]*)")
+   message(STATUS "CODEGEN SKIPPED: ${CMAKE_MATCH_1}")
+   return()
+endif()
+
+set(layout_deviations "")
+string(REGEX MATCHALL "CODEGEN LAYOUT: [a-z_ ]*" declarations "${output}")
+foreach(declaration IN LISTS declarations)
+   string(REGEX REPLACE "^CODEGEN LAYOUT: " "" declaration "${declaration}")
+   string(REGEX REPLACE " +" ";" declaration "${declaration}")
+   list(APPEND layout_deviations ${declaration})
+endforeach()
+
+
+# Extraction of the normalized instruction streams of all 'raw::' and 'strong::' functions. The
+# cold parts of a function (e.g. 'name.cold') are appended to the function itself.
+file(STRINGS ${OUTPUT} lines)
+
+set(current "")
+set(names "")
+
+foreach(line IN LISTS lines)
+   if(line MATCHES "^([A-Za-z_$][A-Za-z0-9_$.]*):")
+      set(current "")
+      if(CMAKE_MATCH_1 MATCHES "^_ZN(3raw|6strong)[0-9]+([a-z_]+)E")
+         set(name ${CMAKE_MATCH_2})
+         string(REGEX REPLACE "^[0-9]+" "" kind "${CMAKE_MATCH_1}")
+         set(current "${kind}_${name}")
+         list(APPEND names ${name})
+      endif()
+   elseif(current STREQUAL "")
+      continue()
+   elseif(line MATCHES "^[ \t]+\\.size[ \t]")
+      set(current "")
+   elseif(line MATCHES "^\\.L[A-Za-z0-9_$.]*:")
+      list(APPEND ${current} "<label>:")
+   elseif(line MATCHES "^[ \t]+([^.# \t][^#]*)")
+      # GCC shares the constants of all functions ('.LC<N>'), i.e. their names are kept
+      string(REGEX REPLACE "\\.LC([0-9]+)" "<LC\\1>" instruction "${CMAKE_MATCH_1}")
+      string(REGEX REPLACE "\\.L[A-Za-z0-9_$.]+" ".L" instruction "${instruction}")
+      string(REGEX REPLACE "[ \t]+" " " instruction "${instruction}")
+      string(STRIP "${instruction}" instruction)
+      list(APPEND ${current} "${instruction}")
+   endif()
+endforeach()
+
+list(REMOVE_DUPLICATES names)
+list(LENGTH names count)
+
+if(count EQUAL 0)
+   message(FATAL_ERROR "CheckCodegen: no 'raw::' and 'strong::' functions found in '${SOURCE}'")
+endif()
+
+
+# Consistent renaming of the scratch registers of an instruction stream: every register that is
+# not part of the calling convention is replaced by the order of the first use of the full
+# register (e.g. '%r10' for '%r10d')
+function(rename_registers instructions result)
+   set(registers "")
+   set(renamed "")
+
+   foreach(instruction IN LISTS ${instructions})
+      set(output "")
+      while(instruction MATCHES "^([^%]*)%([a-z0-9]+)(.*)$")
+         string(APPEND output "${CMAKE_MATCH_1}")
+         set(name ${CMAKE_MATCH_2})
+         set(instruction "${CMAKE_MATCH_3}")
+
+         set(class r)
+         set(register ${name})
+         if(name MATCHES "^([xyz]mm)([0-9]+)$")
+            set(class ${CMAKE_MATCH_1})
+            set(register v${CMAKE_MATCH_2})
+         elseif(name MATCHES "^(r[0-9]+)[dwb]?$")
+            set(register ${CMAKE_MATCH_1})
+         elseif(name MATCHES "^[re]?([abcd])[xlh]$")
+            set(register r${CMAKE_MATCH_1}x)
+         elseif(name MATCHES "^[re]?(si|di|sp|bp|ip)l?$")
+            set(register r${CMAKE_MATCH_1})
+         endif()
+
+         if(register MATCHES "^(rdi|rsi|rdx|rcx|r8|r9|rax|rsp|rip|v[0-7])$")
+            string(APPEND output "%${name}")
+         else()
+            list(FIND registers ${register} index)
+            if(index EQUAL -1)
+               list(LENGTH registers index)
+               list(APPEND registers ${register})
+            endif()
+            string(APPEND output "%${class}<${index}>")
+         endif()
+      endwhile()
+      list(APPEND renamed "${output}${instruction}")
+   endforeach()
+
+   # A comparison for equality is symmetric, i.e. the operands of a 'cmp' instruction followed by
+   # 'je' or 'jne' are sorted
+   list(LENGTH renamed count)
+   if(count GREATER 1)
+      math(EXPR last "${count}-2")
+      foreach(i RANGE ${last})
+         math(EXPR next "${i}+1")
+         list(GET renamed ${i} instruction)
+         list(GET renamed ${next} jump)
+         if(instruction MATCHES "^(cmp[bwlq]?) ([^,()]+), ([^,()]+)$" AND jump MATCHES "^jn?e ")
+            set(opcode ${CMAKE_MATCH_1})
+            set(operands ${CMAKE_MATCH_2} ${CMAKE_MATCH_3})
+            list(SORT operands)
+            string(REPLACE ";" ", " operands "${operands}")
+            list(REMOVE_AT renamed ${i})
+            list(INSERT renamed ${i} "${opcode} ${operands}")
+         endif()
+      endforeach()
+   endif()
+
+   set(${result} "${renamed}" PARENT_SCOPE)
+endfunction()
+
+
+# Removal of the block layout of an instruction stream: labels, jumps and returns are dropped and
+# the remaining instructions are sorted and reduced to unique instructions
+function(remove_layout instructions result)
+   set(remaining ${${instructions}})
+   list(FILTER remaining EXCLUDE REGEX "^(<label>:|j[a-z]+ |ret)")
+   list(REMOVE_DUPLICATES remaining)
+   list(SORT remaining)
+   set(${result} "${remaining}" PARENT_SCOPE)
+endfunction()
+
+
+# Comparison of the instruction streams
+set(failures 0)
+
+foreach(name IN LISTS names)
+   if(NOT DEFINED raw_${name} OR NOT DEFINED strong_${name})
+      message(SEND_ERROR "CheckCodegen: '${name}()' requires both a 'raw::' and a 'strong::' function")
+      math(EXPR failures "${failures}+1")
+      continue()
+   endif()
+
+   set(raw_instructions ${raw_${name}})
+   set(strong_instructions ${strong_${name}})
+   list(FILTER raw_instructions EXCLUDE REGEX "^<label>:$")
+   list(FILTER strong_instructions EXCLUDE REGEX "^<label>:$")
+   list(LENGTH raw_instructions raw_count)
+   list(LENGTH strong_instructions strong_count)
+
+   rename_registers(raw_${name} raw_renamed)
+   rename_registers(strong_${name} strong_renamed)
+   remove_layout(raw_renamed raw_unordered)
+   remove_layout(strong_renamed strong_unordered)
+
+   if(raw_${name} STREQUAL strong_${name})
+      message(STATUS "${name}(): ${raw_count} instruction(s) (identical)")
+   elseif(raw_renamed STREQUAL strong_renamed)
+      message(STATUS "${name}(): ${raw_count} instruction(s) (identical up to register allocation)")
+   elseif(name IN_LIST layout_deviations AND raw_unordered STREQUAL strong_unordered)
+      message(STATUS "${name}(): ${raw_count} vs. ${strong_count} instruction(s) "
+                     "(known deviation: identical up to block layout)")
+   else()
+      string(REPLACE ";" "\n      " raw_listing "${raw_${name}}")
+      string(REPLACE ";" "\n      " strong_listing "${strong_${name}}")
+      message(SEND_ERROR
+         "${name}(): strong type overhead detected (${raw_count} vs. ${strong_count} instruction(s))\n"
+         "   raw::${name}():\n      ${raw_listing}\n"
+         "   strong::${name}():\n      ${strong_listing}\n")
+      math(EXPR failures "${failures}+1")
+   endif()
+endforeach()
+
+if(NOT failures EQUAL 0)
+   message(FATAL_ERROR "CheckCodegen: ${failures} of ${count} function(s) differ for ${OPTIMIZATION}")
+endif()
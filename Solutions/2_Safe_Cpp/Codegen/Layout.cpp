@@ -0,0 +1,41 @@
+/**************************************************************************************************
+*
+* \file Codegen/Layout.cpp
+* \brief C++ Training - Self-test of the known block layout deviations of the codegen verification
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Both functions in this file are declared as known deviations in the block layout. The check of
+* 'clamp()' is expected to pass, since its strong function differs from the raw function by the
+* form of the branch only. The check of 'clamp_to_one()' is expected to fail, since its strong
+* function clamps to a different bound, which must not be mistaken for a different block layout.
+*
+**************************************************************************************************/
+
+#pragma message( "CODEGEN LAYOUT: clamp clamp_to_one" )
+
+
+namespace raw {
+
+double clamp( double lhs, double rhs ) { double const sum{ lhs + rhs }; return sum < 0.0 ? 0.0 : sum; }
+double clamp_to_one( double lhs, double rhs ) { double const sum{ lhs + rhs }; return sum < 0.0 ? 0.0 : sum; }
+
+} // namespace raw
+
+
+namespace strong {
+
+inline void enforce( double& value, bool valid, double closest )
+{
+   if( !valid ) {
+      value = closest;
+   }
+}
+
+double clamp( double lhs, double rhs ) { double sum{ lhs + rhs }; enforce( sum, !( sum < 0.0 ), 0.0 ); return sum; }
+double clamp_to_one( double lhs, double rhs ) { double sum{ lhs + rhs }; enforce( sum, !( sum < 1.0 ), 1.0 ); return sum; }
+
+} // namespace strong
@@ -0,0 +1,44 @@
+/**************************************************************************************************
+*
+* \file Codegen/Meter_Assembly.cpp
+* \brief C++ Training - Codegen verification of the 'Meter' class template
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Every function in namespace 'strong' must compile to exactly the same instructions as the
+* according function on the underlying type in namespace 'raw' (see 'CheckCodegen.cmake').
+*
+**************************************************************************************************/
+
+#include "../Meter_Assembly.cpp"
+
+
+namespace raw {
+
+int test( int meter ) { return ::test( meter ); }
+
+int construct( int value ) { return value; }
+int get( int const& meter ) { return meter; }
+
+void assign( int& lhs, int rhs ) { lhs = rhs; }
+
+std::ostream& print( std::ostream& os, int meter ) { return os << meter; }
+
+} // namespace raw
+
+
+namespace strong {
+
+Meter<int> test( Meter<int> meter ) { return ::test( meter ); }
+
+Meter<int> construct( int value ) { return Meter<int>{ value }; }
+int get( Meter<int> const& meter ) { return meter.get(); }
+
+void assign( Meter<int>& lhs, Meter<int> rhs ) { lhs = rhs; }
+
+std::ostream& print( std::ostream& os, Meter<int> meter ) { return os << meter; }
+
+} // namespace strong
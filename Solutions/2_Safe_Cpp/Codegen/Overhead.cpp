@@ -0,0 +1,41 @@
+/**************************************************************************************************
+*
+* \file Codegen/Overhead.cpp
+* \brief C++ Training - Self-test of the codegen verification
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The check of this file is expected to fail: due to the user-provided destructor 'Meter' is
+* not trivially copyable and is therefore passed and returned via memory instead of registers.
+*
+**************************************************************************************************/
+
+
+class Meter
+{
+ public:
+   explicit Meter( int value ) : value_{ value } {}
+   ~Meter() {}
+
+   int get() const { return value_; }
+
+ private:
+   int value_;
+};
+
+
+namespace raw {
+
+int test( int meter ) { return meter+7; }
+
+} // namespace raw
+
+
+namespace strong {
+
+Meter test( Meter meter ) { return Meter{ meter.get()+7 }; }
+
+} // namespace strong
@@ -0,0 +1,46 @@
+/**************************************************************************************************
+*
+* \file Codegen/StrongType_Assembly.cpp
+* \brief C++ Training - Codegen verification of the 'StrongType' class template
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Every function in namespace 'strong' must compile to exactly the same instructions as the
+* according function on the underlying type in namespace 'raw' (see 'CheckCodegen.cmake').
+*
+**************************************************************************************************/
+
+#include "../StrongType_Assembly.cpp"
+
+
+namespace raw {
+
+int test( int meter ) { return ::test( meter ); }
+
+int construct( int value ) { return value; }
+int get( int const& meter ) { return meter; }
+
+void assign( int& lhs, int rhs ) { lhs = rhs; }
+void swap_values( int& a, int& b ) { std::ranges::swap( a, b ); }
+
+std::ostream& print( std::ostream& os, int meter ) { return os << meter; }
+
+} // namespace raw
+
+
+namespace strong {
+
+Meter test( Meter meter ) { return ::test( meter ); }
+
+Meter construct( int value ) { return Meter{ value }; }
+int get( Meter const& meter ) { return meter.get(); }
+
+void assign( Meter& lhs, int rhs ) { lhs = rhs; }
+void swap_values( Meter& a, Meter& b ) { swap( a, b ); }
+
+std::ostream& print( std::ostream& os, Meter meter ) { return os << meter; }
+
+} // namespace strong
@@ -0,0 +1,99 @@
+/**************************************************************************************************
+*
+* \file Codegen/StrongType_CheckPolicy.cpp
+* \brief C++ Training - Codegen verification of the check policies of strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Every function in namespace 'strong' must compile to exactly the same instructions as the
+* according function on the underlying type in namespace 'raw' (see 'CheckCodegen.cmake').
+*
+**************************************************************************************************/
+
+#define NDEBUG
+#include "../StrongType_CheckPolicy.cpp"
+
+
+namespace raw {
+
+double add_throw( double lhs, double rhs )
+{
+   double const sum{ lhs + rhs };
+   if( sum < 0.0 ) {
+      throw std::invalid_argument( "Negative value detected" );
+   }
+   return sum;
+}
+
+double add_assert( double lhs, double rhs ) { return lhs + rhs; }
+double add_assume( double lhs, double rhs ) { return lhs + rhs; }
+
+// Known deviation: GCC decides on the block layout of the clamp by means of its branch heuristics
+// before inlining. In 'Saturate::enforce()' the branch depends on a 'bool' parameter, in the raw
+// functions on a comparison, which results in a different order (and duplication) of the blocks
+// for some optimization levels. The instructions themselves are the same.
+#pragma message( "CODEGEN LAYOUT: add_saturate assign_saturate" )
+
+double add_saturate( double lhs, double rhs )
+{
+   double const sum{ lhs + rhs };
+   return sum < 0.0 ? 0.0 : sum;
+}
+
+void assign_throw( double& lhs, double rhs )
+{
+   if( rhs < 0.0 ) {
+      throw std::invalid_argument( "Negative value detected" );
+   }
+   lhs = rhs;
+}
+
+void assign_saturate( double& lhs, double rhs )
+{
+   lhs = rhs < 0.0 ? 0.0 : rhs;
+}
+
+// The fast policies must not prevent the vectorization of loops. The loops read a single span
+// only, since GCC orders the runtime alias checks of several spans arbitrarily.
+void add_loop_assert( std::span<double const> a, double b, std::span<double> c )
+{
+   for( std::size_t i=0U; i<c.size(); ++i ) {
+      c[i] = a[i] + b;
+   }
+}
+
+void add_loop_assume( std::span<double const> a, double b, std::span<double> c )
+{
+   for( std::size_t i=0U; i<c.size(); ++i ) {
+      c[i] = a[i] + b;
+   }
+}
+
+} // namespace raw
+
+
+namespace strong {
+
+Meter<double,PositiveOrThrow> add_throw( Meter<double,PositiveOrThrow> lhs, Meter<double,PositiveOrThrow> rhs ) { return lhs + rhs; }
+Meter<double,PositiveOrAssert> add_assert( Meter<double,PositiveOrAssert> lhs, Meter<double,PositiveOrAssert> rhs ) { return lhs + rhs; }
+Meter<double,AssumePositive> add_assume( Meter<double,AssumePositive> lhs, Meter<double,AssumePositive> rhs ) { return lhs + rhs; }
+Meter<double,ClampToPositive> add_saturate( Meter<double,ClampToPositive> lhs, Meter<double,ClampToPositive> rhs ) { return lhs + rhs; }
+
+void assign_throw( Meter<double,PositiveOrThrow>& lhs, double rhs ) { lhs = rhs; }
+void assign_saturate( Meter<double,ClampToPositive>& lhs, double rhs ) { lhs = rhs; }
+
+template< typename S >
+void add_loop( std::span<S const> a, S b, std::span<S> c )
+{
+   for( std::size_t i=0U; i<c.size(); ++i ) {
+      c[i] = a[i] + b;
+   }
+}
+
+void add_loop_assert( std::span<Meter<double,PositiveOrAssert> const> a, Meter<double,PositiveOrAssert> b, std::span<Meter<double,PositiveOrAssert>> c ) { add_loop( a, b, c ); }
+void add_loop_assume( std::span<Meter<double,AssumePositive> const> a, Meter<double,AssumePositive> b, std::span<Meter<double,AssumePositive>> c ) { add_loop( a, b, c ); }
+
+} // namespace strong
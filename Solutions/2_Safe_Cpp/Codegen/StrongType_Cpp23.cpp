@@ -0,0 +1,97 @@
+/**************************************************************************************************
+*
+* \file Codegen/StrongType_Cpp23.cpp
+* \brief C++ Training - Codegen verification of the C++23 'StrongType' implementation
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Every function in namespace 'strong' must compile to exactly the same instructions as the
+* according function on the underlying type in namespace 'raw' (see 'CheckCodegen.cmake').
+*
+**************************************************************************************************/
+
+#if defined(__cpp_explicit_this_parameter)
+
+#include "../StrongType_Cpp23.cpp"
+
+
+namespace raw {
+
+int construct( int value ) { return value; }
+
+int add( int lhs, int rhs ) { return lhs + rhs; }
+int subtract( int lhs, int rhs ) { return lhs - rhs; }
+void add_assign( int& lhs, int rhs ) { lhs += rhs; }
+void subtract_assign( int& lhs, int rhs ) { lhs -= rhs; }
+
+bool equal( int lhs, int rhs ) { return lhs == rhs; }
+bool not_equal( int lhs, int rhs ) { return lhs != rhs; }
+
+void assign( int& lhs, int rhs ) { lhs = rhs; }
+void swap_values( int& a, int& b ) { std::ranges::swap( a, b ); }
+
+void print( std::ostream& os, int value ) { os << value; }
+
+// Positive
+long check( long value )
+{
+   if( value < 0L ) {
+      throw std::invalid_argument( "Negative value detected" );
+   }
+   return value;
+}
+
+long add_positive( long lhs, long rhs )
+{
+   long const sum{ lhs + rhs };
+   if( sum < 0L ) {
+      throw std::invalid_argument( "Negative value detected" );
+   }
+   return sum;
+}
+
+void assign_positive( long& lhs, long rhs )
+{
+   if( rhs < 0L ) {
+      throw std::invalid_argument( "Negative value detected" );
+   }
+   lhs = rhs;
+}
+
+} // namespace raw
+
+
+namespace strong {
+
+Kilometer<int> construct( int value ) { return Kilometer<int>{ value }; }
+
+Kilometer<int> add( Kilometer<int> lhs, Kilometer<int> rhs ) { return lhs + rhs; }
+Kilometer<int> subtract( Kilometer<int> lhs, Kilometer<int> rhs ) { return lhs - rhs; }
+void add_assign( Kilometer<int>& lhs, Kilometer<int> rhs ) { lhs += rhs; }
+void subtract_assign( Kilometer<int>& lhs, Kilometer<int> rhs ) { lhs -= rhs; }
+
+bool equal( Kilometer<int> lhs, Kilometer<int> rhs ) { return lhs == rhs; }
+bool not_equal( Kilometer<int> lhs, Kilometer<int> rhs ) { return lhs != rhs; }
+
+void assign( Kilometer<int>& lhs, int rhs ) { lhs = rhs; }
+void swap_values( Kilometer<int>& a, Kilometer<int>& b ) { swap( a, b ); }
+
+void print( std::ostream& os, Kilometer<int> value ) { value.print( os ); }
+
+// Positive
+Meter<long> check( long value ) { return Meter<long>{ value }; }
+
+Meter<long> add_positive( Meter<long> lhs, Meter<long> rhs ) { return lhs + rhs; }
+void assign_positive( Meter<long>& lhs, long rhs ) { lhs = rhs; }
+
+} // namespace strong
+
+
+#else
+
+#pragma message( "CODEGEN SKIPPED: explicit object parameters (deducing this) are not supported" )
+
+#endif
@@ -0,0 +1,62 @@
+/**************************************************************************************************
+*
+* \file Codegen/StrongType_Dimensions.cpp
+* \brief C++ Training - Codegen verification of the dimensional analysis with strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Every function in namespace 'strong' must compile to exactly the same instructions as the
+* according function on the underlying type in namespace 'raw' (see 'CheckCodegen.cmake'). In
+* particular, all scale factors of a computation must be fused into a single constant factor.
+*
+**************************************************************************************************/
+
+#include "../StrongType_Dimensions.cpp"
+
+
+namespace raw {
+
+// m / (km/h) = 3.6 s
+double time_for( double distance, double speed ) { return distance / speed * 3.6; }
+
+// km/h = 5/18 m/s
+double to_meter_per_second( double speed ) { return speed * ( 5.0 / 18.0 ); }
+
+// km/h * s / cm = 250/9
+double body_lengths( double speed, double time, double size )
+{
+   return speed * time / size * ( 250.0 / 9.0 );
+}
+
+// m / cm = 100
+double relative_length( double length, double reference ) { return length / reference * 100.0; }
+
+} // namespace raw
+
+
+namespace strong {
+
+Second<double> time_for( Meter<double> distance, KilometerPerHour<double> speed )
+{
+   return quantity_cast<Second<double>>( distance / speed );
+}
+
+MeterPerSecond<double> to_meter_per_second( KilometerPerHour<double> speed )
+{
+   return quantity_cast<MeterPerSecond<double>>( speed );
+}
+
+double body_lengths( KilometerPerHour<double> speed, Second<double> time, Centimeter<double> size )
+{
+   return speed * time / size;
+}
+
+double relative_length( Meter<double> length, Centimeter<double> reference )
+{
+   return length / reference;
+}
+
+} // namespace strong
@@ -0,0 +1,77 @@
+/**************************************************************************************************
+*
+* \file Codegen/StrongType_Index.cpp
+* \brief C++ Training - Codegen verification of strongly typed indices and spans
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Every function in namespace 'strong' must compile to exactly the same instructions as the
+* according function on the underlying type in namespace 'raw' (see 'CheckCodegen.cmake'). In
+* particular, the bounds check of 'StrongSpan::at()' must vanish within a loop over 'indices()'.
+*
+**************************************************************************************************/
+
+#include "../StrongType_Index.cpp"
+
+
+namespace raw {
+
+double sum( std::span<double const> values )
+{
+   double result{};
+   for( std::size_t i=0U; i<values.size(); ++i ) {
+      result += values[i];
+   }
+   return result;
+}
+
+void scale( std::span<double> values, double factor )
+{
+   for( std::size_t i=0U; i<values.size(); ++i ) {
+      values[i] *= factor;
+   }
+}
+
+std::size_t count_negative( std::span<long const> values )
+{
+   std::size_t count{};
+   for( std::size_t i=0U; i<values.size(); ++i ) {
+      count += ( values[i] < 0L );
+   }
+   return count;
+}
+
+} // namespace raw
+
+
+namespace strong {
+
+double sum( StrongSpan<double const,Sensors> values )
+{
+   double result{};
+   for( auto const i : indices( values ) ) {
+      result += values.at(i);
+   }
+   return result;
+}
+
+void scale( StrongSpan<double,Sensors> values, double factor )
+{
+   for( auto const i : indices( values ) ) {
+      values.at(i) *= factor;
+   }
+}
+
+std::size_t count_negative( StrongSpan<long const,Sensors> values )
+{
+   std::size_t count{};
+   for( auto const i : indices( values ) ) {
+      count += ( values.at(i) < 0L );
+   }
+   return count;
+}
+
+} // namespace strong
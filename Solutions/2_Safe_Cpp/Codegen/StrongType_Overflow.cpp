@@ -0,0 +1,52 @@
+/**************************************************************************************************
+*
+* \file Codegen/StrongType_Overflow.cpp
+* \brief C++ Training - Codegen verification of the overflow-aware arithmetic skills
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Every function in namespace 'strong' must compile to exactly the same instructions as the
+* according function on the underlying type in namespace 'raw' (see 'CheckCodegen.cmake').
+*
+**************************************************************************************************/
+
+#include "../StrongType_Overflow.cpp"
+
+
+namespace raw {
+
+// GCC commutes the operands of the inlined 'checked_add()', i.e. the reference adds in the same
+// order to get the same register allocation
+long checked( long lhs, long rhs )
+{
+   long result{};
+   if( __builtin_add_overflow( rhs, lhs, &result ) ) {
+      throw std::overflow_error( "Integer overflow detected" );
+   }
+   return result;
+}
+
+std::uint8_t saturating( std::uint8_t lhs, std::uint8_t rhs )
+{
+   std::uint8_t result{};
+   return __builtin_add_overflow( lhs, rhs, &result ) ? std::uint8_t{ 255U } : result;
+}
+
+std::uint16_t wrapping( std::uint16_t lhs, std::uint16_t rhs )
+{
+   return static_cast<std::uint16_t>( lhs + rhs );
+}
+
+} // namespace raw
+
+
+namespace strong {
+
+Meter<long> checked( Meter<long> lhs, Meter<long> rhs ) { return lhs + rhs; }
+Intensity saturating( Intensity lhs, Intensity rhs ) { return lhs + rhs; }
+SequenceNumber wrapping( SequenceNumber lhs, SequenceNumber rhs ) { return lhs + rhs; }
+
+} // namespace strong
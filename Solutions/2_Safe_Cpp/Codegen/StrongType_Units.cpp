@@ -0,0 +1,43 @@
+/**************************************************************************************************
+*
+* \file Codegen/StrongType_Units.cpp
+* \brief C++ Training - Codegen verification of the compile time unit conversions
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Every function in namespace 'strong' must compile to exactly the same instructions as the
+* according function on the underlying type in namespace 'raw' (see 'CheckCodegen.cmake'). In
+* particular, every unit conversion must fold to a single multiplication or division.
+*
+**************************************************************************************************/
+
+#include "../StrongType_Units.cpp"
+
+
+namespace raw {
+
+double to_meter( double kilometer ) { return kilometer * 1000.0; }
+long to_meter_integral( long kilometer ) { return kilometer * 1000L; }
+
+double to_kilometer( double meter ) { return meter * 0.001; }
+long to_kilometer_integral( long meter ) { return meter / 1000L; }
+
+long add_mixed( long kilometer, long meter ) { return kilometer * 1000L + meter; }
+
+} // namespace raw
+
+
+namespace strong {
+
+Meter<double> to_meter( Kilometer<double> kilometer ) { return quantity_cast<Meter<double>>( kilometer ); }
+Meter<long> to_meter_integral( Kilometer<long> kilometer ) { return quantity_cast<Meter<long>>( kilometer ); }
+
+Kilometer<double> to_kilometer( Meter<double> meter ) { return quantity_cast<Kilometer<double>>( meter ); }
+Kilometer<long> to_kilometer_integral( Meter<long> meter ) { return quantity_cast<Kilometer<long>>( meter ); }
+
+Meter<long> add_mixed( Kilometer<long> kilometer, Meter<long> meter ) { return kilometer + meter; }
+
+} // namespace strong
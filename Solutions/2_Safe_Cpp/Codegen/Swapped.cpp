@@ -0,0 +1,31 @@
+/**************************************************************************************************
+*
+* \file Codegen/Swapped.cpp
+* \brief C++ Training - Self-test of the register renaming of the codegen verification
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* The check of both functions in this file is expected to fail: the strong functions differ from
+* the raw functions only by the order of the arguments of a non-commutative operation, which
+* must not be mistaken for a different register allocation.
+*
+**************************************************************************************************/
+
+
+namespace raw {
+
+long difference( long lhs, long rhs ) { return lhs - rhs; }
+long scaled_difference( long lhs, long rhs, long factor ) { return ( lhs - rhs ) * factor; }
+
+} // namespace raw
+
+
+namespace strong {
+
+long difference( long lhs, long rhs ) { return rhs - lhs; }
+long scaled_difference( long lhs, long rhs, long factor ) { return ( lhs - factor ) * rhs; }
+
+} // namespace strong
@@ -0,0 +1,155 @@
+#==================================================================================================
+#
+#  Compile-time benchmark for the C++ Training
+#
+#  Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+#
+#  This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+#  context of the C++ training or with explicit agreement by Klaus Iglberger.
+#
+#==================================================================================================
+#
+#  Usage: cmake -DCOMPILER=<c++> -DSTANDARD=<c++20> -DSOURCE=<StrongType.cpp> -DTYPES=<100,300>
+#               -DSKILLS=<0,8> -DOUTPUT=<directory> [-DFEATURES=<__cpp_concepts,...>]
+#               -P CompileTimeBenchmark.cmake
+#
+#  For every combination of N in 'TYPES' and M in 'SKILLS' a translation unit is generated, which
+#  includes the given 'StrongType' implementation and defines N strong types with the skills
+#  'IntegralArithmetic', 'Printable' and 'EqualityComparable' plus M additional skills. Every
+#  strong type is used once (construction, assignment, arithmetic, comparison, output, swap and
+#  all additional skills). The translation unit is compiled with '-fsyntax-only' (i.e. without
+#  code generation) and the compile time and (for GCC) the memory consumption are reported.
+#
+#  The additional skills are generated as class templates (CRTP) if the 'StrongType' of the
+#  given implementation expects class templates, otherwise as regular classes. If the compiler
+#  doesn't support the given standard or doesn't define all feature-test macros in 'FEATURES',
+#  the implementation is skipped ("COMPILETIME SKIPPED"). Any other compilation error is reported
+#  as failure.
+#
+#==================================================================================================
+
+cmake_minimum_required(VERSION 3.10 FATAL_ERROR)
+
+foreach(variable COMPILER STANDARD SOURCE TYPES SKILLS OUTPUT)
+   if(NOT DEFINED ${variable})
+      message(FATAL_ERROR "CompileTimeBenchmark: '${variable}' is not defined")
+   endif()
+endforeach()
+
+string(REPLACE "," ";" TYPES "${TYPES}")
+string(REPLACE "," ";" SKILLS "${SKILLS}")
+string(REPLACE "," ";" FEATURES "${FEATURES}")
+
+get_filename_component(subject ${SOURCE} NAME_WE)
+file(MAKE_DIRECTORY ${OUTPUT})
+
+# Compiles the given file and stores the wall clock time (in ms, if supported by CMake) and the
+# GGC memory reported by GCC
+function(compile FILE RESULT TIME MEMORY)
+   string(TIMESTAMP start "%s%f")
+   execute_process(
+      COMMAND ${COMPILER} -std=${STANDARD} -fsyntax-only -ftime-report ${FILE}
+      RESULT_VARIABLE result
+      OUTPUT_VARIABLE output
+      ERROR_VARIABLE output
+      )
+   string(TIMESTAMP stop "%s%f")
+
+   set(time "n/a")
+   if(start MATCHES "^[0-9]+$" AND stop MATCHES "^[0-9]+$")
+      math(EXPR time "(${stop} - ${start}) / 1000")
+      set(time "${time}ms")
+   endif()
+
+   set(memory "n/a")
+   if(output MATCHES "\n TOTAL[^\n]*[ \t]([0-9]+[kMG])[ \t]*\n")
+      set(memory ${CMAKE_MATCH_1})
+   endif()
+
+   set(${RESULT} ${result} PARENT_SCOPE)
+   set(${TIME} ${time} PARENT_SCOPE)
+   set(${MEMORY} ${memory} PARENT_SCOPE)
+
+   if(NOT result EQUAL 0)
+      set(output_${FILE} "${output}" PARENT_SCOPE)
+   endif()
+endfunction()
+
+
+# Implementations are skipped only if the compiler lacks the requested standard or one of the
+# required language/library features (e.g. missing C++23 support)
+set(probe ${OUTPUT}/${subject}_Probe.cpp)
+set(code "#include <version>\n")
+foreach(feature IN LISTS FEATURES)
+   string(APPEND code "#ifndef ${feature}\n#error \"${feature} is not defined\"\n#endif\n")
+endforeach()
+file(WRITE ${probe} "${code}")
+
+compile(${probe} result time memory)
+if(NOT result EQUAL 0)
+   message(STATUS "COMPILETIME SKIPPED: '${COMPILER} -std=${STANDARD}' doesn't support "
+                  "'${subject}':\n${output_${probe}}")
+   return()
+endif()
+
+compile(${SOURCE} result time memory)
+if(NOT result EQUAL 0)
+   message(FATAL_ERROR "CompileTimeBenchmark: compilation of '${SOURCE}' failed:\n${output_${SOURCE}}")
+endif()
+
+file(READ ${SOURCE} source)
+if(source MATCHES "template<typename\\.\\.\\.> class\\.\\.\\. Skills")
+   set(crtp TRUE)
+else()
+   set(crtp FALSE)
+endif()
+
+foreach(types IN LISTS TYPES)
+   foreach(skills IN LISTS SKILLS)
+      set(file ${OUTPUT}/${subject}_N${types}_M${skills}.cpp)
+      set(code "#include \"${SOURCE}\"\n\n")
+
+      set(skill_list "IntegralArithmetic,Printable,EqualityComparable")
+      set(skill_uses "")
+      if(skills GREATER 0)
+         math(EXPR last "${skills}-1")
+         foreach(k RANGE ${last})
+            if(crtp)
+               string(APPEND code
+                  "template< typename Derived >\n"
+                  "struct Skill${k}\n{\n"
+                  "   friend constexpr Derived twice${k}( Derived const& d ) { return Derived{ d.get() + d.get() }; }\n"
+                  "};\n\n")
+            else()
+               string(APPEND code
+                  "struct Skill${k}\n{\n"
+                  "   template< typename S >\n"
+                  "      requires std::is_base_of_v<Skill${k},S>\n"
+                  "   friend constexpr S twice${k}( S const& s ) { return S{ s.get() + s.get() }; }\n"
+                  "};\n\n")
+            endif()
+            string(APPEND skill_list ",Skill${k}")
+            string(APPEND skill_uses " a = twice${k}( a );")
+         endforeach()
+      endif()
+
+      math(EXPR last "${types}-1")
+      foreach(i RANGE ${last})
+         string(APPEND code
+            "using S${i} = StrongType<long,struct Tag${i},${skill_list}>;\n"
+            "long use${i}( long x )\n{\n"
+            "   S${i} a{ x }; S${i} b{ 2 }; a = 3; a = b; a += b; S${i} c{ a + b - b };${skill_uses}\n"
+            "   std::cout << c; swap( a, b );\n"
+            "   return ( a == c ) ? a.get() : b.get();\n}\n\n")
+      endforeach()
+
+      file(WRITE ${file} "${code}")
+
+      compile(${file} result time memory)
+      if(NOT result EQUAL 0)
+         message(FATAL_ERROR "CompileTimeBenchmark: compilation of '${file}' failed:\n${output_${file}}")
+      endif()
+
+      message(STATUS "${subject}: N=${types} M=${skills}: time=${time} memory=${memory}")
+   endforeach()
+endforeach()
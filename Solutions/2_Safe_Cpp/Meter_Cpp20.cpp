@@ -37,7 +37,10 @@
 // 11. The assignment operators could be marked with an lvalue reference qualifier
 
 #include <concepts>
+#include <cstddef>
+#include <limits>
 #include <ostream>
+#include <stdexcept>
 #include <type_traits>
 
 template< typename T >
@@ -73,13 +76,79 @@ class Meter final
 template< typename T >
 Meter( T ) -> Meter<T>;  // User-defined deduction guide
 
-constexpr Meter<long> operator""_m( unsigned long long meter )  // User-defined literal
+namespace detail {
+
+// Parses the digits of an integer literal (decimal, hexadecimal, binary or octal, with optional
+// digit separators) at compile time. Values exceeding 'unsigned long long' are rejected.
+template< char... Chars >
+consteval unsigned long long parse_integer_literal()
 {
-   return Meter<long>{ static_cast<long>( meter ) };
+   constexpr char chars[]{ Chars... };
+   constexpr std::size_t size{ sizeof...(Chars) };
+
+   unsigned long long base{ 10U };
+   std::size_t i{ 0U };
+
+   if( size > 1U && chars[0] == '0' ) {
+      if( chars[1] == 'x' || chars[1] == 'X' )      { base = 16U; i = 2U; }
+      else if( chars[1] == 'b' || chars[1] == 'B' ) { base =  2U; i = 2U; }
+      else                                          { base =  8U; i = 1U; }
+   }
+
+   unsigned long long value{ 0U };
+
+   for( ; i<size; ++i )
+   {
+      char const c{ chars[i] };
+      if( c == '\'' ) continue;
+
+      unsigned long long const digit =
+         ( c >= '0' && c <= '9' ) ? static_cast<unsigned long long>( c - '0' ) :
+         ( c >= 'a' && c <= 'f' ) ? static_cast<unsigned long long>( c - 'a' + 10 ) :
+         ( c >= 'A' && c <= 'F' ) ? static_cast<unsigned long long>( c - 'A' + 10 ) : base;
+
+      if( digit >= base ) {
+         throw std::invalid_argument( "Invalid digit in integer literal" );
+      }
+      if( value > ( std::numeric_limits<unsigned long long>::max() - digit ) / base ) {
+         throw std::out_of_range( "Integer literal out of range" );
+      }
+
+      value = value*base + digit;
+   }
+
+   return value;
 }
 
-constexpr Meter<double> operator""_m( long double meter )  // User-defined literal
+// The narrowest type that can represent the given value exactly (same as for integer literals
+// without suffix)
+template< unsigned long long Value >
+using narrowest_integer_t =
+   std::conditional_t< Value <= static_cast<unsigned long long>( std::numeric_limits<int>::max() ), int,
+   std::conditional_t< Value <= static_cast<unsigned long long>( std::numeric_limits<long>::max() ), long,
+                       long long > >;
+
+} // namespace detail
+
+// User-defined literal (literal operator template): the digits are parsed at compile time, the
+// resulting 'Meter' uses the narrowest type that represents the value exactly (in contrast to
+// a 'static_cast', which would silently wrap large values)
+template< char... Chars >
+consteval auto operator""_m()
 {
+   constexpr unsigned long long meter{ detail::parse_integer_literal<Chars...>() };
+   static_assert( meter <= static_cast<unsigned long long>( std::numeric_limits<long long>::max() )
+                , "Meter literal out of range" );
+
+   using T = detail::narrowest_integer_t<meter>;
+   return Meter<T>{ static_cast<T>( meter ) };
+}
+
+consteval Meter<double> operator""_m( long double meter )  // User-defined literal
+{
+   if( meter > std::numeric_limits<double>::max() ) {
+      throw std::out_of_range( "Meter literal out of range" );
+   }
    return Meter<double>{ static_cast<double>( meter ) };
 }
 
@@ -116,7 +185,20 @@ int main()
 
    //Meter meter5{ meter1 + meter2 };  // Does not compile
 
+   constexpr Meter meter6{ 100_m };  // Meter<int>
+   static_assert( std::same_as<decltype(meter6),Meter<int> const> );
+   static_assert( meter6.get() == 100 );
+
+   constexpr Meter meter7{ 3'000'000'000_m };  // Meter<long> (does not fit into 'int')
+   static_assert( std::same_as<decltype(meter7),Meter<long> const> );
+   static_assert( meter7.get() == 3'000'000'000L );
+
+   static_assert( ( 0x10_m ).get() == 16 );
+   static_assert( ( 2.5_m ).get() == 2.5 );
+
    //5_m = -21_m;  // Does and should not compile (this contains 2 problems).
+   //auto const meter8 = 9'223'372'036'854'775'808_m;  // Does not compile (literal out of range)
+   //auto const meter9 = 1e400_m;                       // Does not compile (literal out of range)
 
    return EXIT_SUCCESS;
 }
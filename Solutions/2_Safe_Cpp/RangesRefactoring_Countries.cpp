@@ -18,38 +18,448 @@
 * Step 4: Refactor the 'main()' function from an imperative to a declarative style by means
 *         of C++20 ranges.
 *
+* Step 5: Parallelize the materialization of the countries by means of 'par_to<>()'.
+*
 **************************************************************************************************/
 
 
 //---- <ranges> -----------------------------------------------------------------------------------
 
 #include <concepts>
+#include <cstddef>
+#include <memory>
 #include <ranges>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+
+// Simplified implementation of C++23 'std::ranges::to<>()'. The elements are appended one by one
+// after reserving the required capacity (if the container provides a 'reserve()' function):
+//  - for sized ranges, the capacity is given by the size of the range
+//  - for unsized ranges, an explicit 'size_hint' can be given (e.g. an estimate or upper bound)
+//  - for unsized forward ranges, 'two_pass' counts the elements in a first pass (i.e. all views
+//    are evaluated twice, but the container allocates only once)
+// The elements of owning rvalue ranges (e.g. a temporary container, or a filtered temporary
+// container) are moved instead of copied. Additional arguments (e.g. an allocator or a
+// 'std::pmr::memory_resource') are passed to the constructor of the container.
+
+// The expected number of elements of an unsized range
+struct size_hint
+{
+   std::size_t value{};
+};
+
+// Request to count the elements of a forward range before materializing it
+struct two_pass_t
+{
+   explicit two_pass_t() = default;
+};
+
+inline constexpr two_pass_t two_pass{};
+
+namespace detail {
+
+template< typename C >
+concept Reservable = requires( C& c, std::size_t n ) { c.reserve( n ); };
+
+template< typename A >
+concept Allocator = requires( A& a, std::size_t n ) {
+   typename A::value_type;
+   a.allocate( n );
+};
+
+// The container type: 'C<T>', or 'C<T,Alloc>' for an allocator that is not usable for 'C<T>'
+template< template<typename...> class C, typename T, typename... Args >
+struct container
+{
+   using type = C<T>;
+};
+
+template< template<typename...> class C, typename T, typename A >
+   requires ( Allocator<A> && !std::constructible_from<C<T>,A const&> )
+struct container<C,T,A>
+{
+   using type = C< T, typename std::allocator_traits<A>::template rebind_alloc<T> >;
+};
+
+template< template<typename...> class C, typename T, typename... Args >
+using container_t = typename container<C,T,std::remove_cvref_t<Args>...>::type;
+
+// Ranges that own their elements: containers (i.e. non-view ranges), 'owning_view' and all
+// views that preserve the identity of the elements of an owning range
+template< typename R >
+constexpr bool owns_elements_v = !std::ranges::view<R>;
+
+template< typename R >
+constexpr bool owns_elements_v< std::ranges::owning_view<R> > = true;
 
-// Simplified implementation of C++23 'std::ranges::to<>()'
-template< template<typename...> class C >
+template< typename V, typename P >
+constexpr bool owns_elements_v< std::ranges::filter_view<V,P> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::take_view<V> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::drop_view<V> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::reverse_view<V> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::common_view<V> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::join_view<V> > = owns_elements_v<V>;
+
+// The elements of an rvalue of an owning range can be moved (as 'std::views::as_rvalue' would)
+template< typename R >
+concept MovableElements = !std::is_lvalue_reference_v<R> && owns_elements_v< std::remove_cvref_t<R> >;
+
+template< typename C, typename T >
+constexpr void append( C& c, T&& value )
+{
+   if constexpr( requires { c.push_back( std::forward<T>(value) ); } ) {
+      c.push_back( std::forward<T>(value) );
+   }
+   else {
+      c.insert( c.end(), std::forward<T>(value) );
+   }
+}
+
+template< typename T >
+constexpr bool is_strategy_v = std::same_as<T,size_hint> || std::same_as<T,two_pass_t>;
+
+} // namespace detail
+
+template< template<typename...> class C, typename... Args >
 struct to_range
-{};
+{
+   std::tuple<Args...> args;
+};
 
-template< template<typename...> class C, std::ranges::input_range R >
-constexpr auto to( R&& range )
+template< template<typename...> class C, std::ranges::input_range R, typename... Args >
+constexpr auto to( R&& range, size_hint hint, Args&&... args )
 {
    using T = std::ranges::range_value_t<R>;
    static_assert( !std::is_reference_v<T> );
-   return C<T>( std::ranges::begin(range), std::ranges::end(range) );
+
+   detail::container_t<C,T,Args...> result( std::forward<Args>(args)... );
+
+   if constexpr( detail::Reservable<decltype(result)> )
+   {
+      std::size_t capacity{ hint.value };
+      if constexpr( std::ranges::sized_range<R> ) {
+         capacity = static_cast<std::size_t>( std::ranges::size(range) );
+      }
+      if( capacity > 0U ) {
+         result.reserve( capacity );
+      }
+   }
+
+   if constexpr( detail::MovableElements<R> ) {
+      for( auto it=std::ranges::begin(range); it!=std::ranges::end(range); ++it ) {
+         detail::append( result, std::ranges::iter_move(it) );
+      }
+   }
+   else {
+      for( auto&& value : range ) {
+         detail::append( result, std::forward<decltype(value)>(value) );
+      }
+   }
+
+   return result;
+}
+
+template< template<typename...> class C, std::ranges::forward_range R, typename... Args >
+constexpr auto to( R&& range, two_pass_t, Args&&... args )
+{
+   auto const size = std::ranges::distance( range );
+   return to<C>( std::forward<R>(range), size_hint{ static_cast<std::size_t>( size ) }
+               , std::forward<Args>(args)... );
 }
 
-template< template<typename...> class C >
-constexpr auto to()
+template< template<typename...> class C, std::ranges::input_range R, typename... Args >
+   requires ( !detail::is_strategy_v< std::remove_cvref_t<Args> > && ... )
+constexpr auto to( R&& range, Args&&... args )
 {
-   return to_range<C>{};
+   return to<C>( std::forward<R>(range), size_hint{}, std::forward<Args>(args)... );
 }
 
-template< std::ranges::input_range R, template<typename...> class C >
-constexpr auto operator|( R&& range, to_range<C> )
+template< template<typename...> class C, typename... Args >
+   requires ( !std::ranges::range< std::remove_cvref_t<Args> > && ... )
+constexpr auto to( Args&&... args )
 {
-   return to<C>(range);
+   return to_range< C, std::decay_t<Args>... >{ { std::forward<Args>(args)... } };
+}
+
+template< std::ranges::input_range R, template<typename...> class C, typename... Args >
+constexpr auto operator|( R&& range, to_range<C,Args...> const& adaptor )
+{
+   return std::apply( [&range]( auto const&... args ){ return to<C>( std::forward<R>(range), args... ); }
+                    , adaptor.args );
+}
+
+
+//---- <ThreadPool.h> -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads. 'run()' blocks until all of its tasks have finished and must
+// therefore not be called from within a task.
+class ThreadPool
+{
+ public:
+   explicit ThreadPool( unsigned int threads = std::thread::hardware_concurrency() )
+   {
+      threads = std::max( threads, 1U );
+      workers_.reserve( threads );
+      for( unsigned int t=0U; t<threads; ++t ) {
+         workers_.emplace_back( [this]( std::stop_token token ){ work( token ); } );
+      }
+   }
+
+   ThreadPool( ThreadPool const& ) = delete;
+   ThreadPool& operator=( ThreadPool const& ) = delete;
+
+   std::size_t size() const noexcept { return workers_.size(); }
+
+   // Executes 'task(0)', ..., 'task(count-1)' on the worker threads. If tasks throw, the exception
+   // of the first of these tasks is rethrown after all tasks have finished.
+   template< typename Task >
+   void run( std::size_t count, Task const& task )
+   {
+      std::vector< std::future<void> > results{};
+      results.reserve( count );
+      {
+         std::scoped_lock lock{ mutex_ };
+         for( std::size_t i=0U; i<count; ++i ) {
+            std::packaged_task<void()> job{ [&task,i]{ task( i ); } };
+            results.push_back( job.get_future() );
+            jobs_.push( std::move(job) );
+         }
+      }
+      condition_.notify_all();
+
+      for( auto& result : results ) {
+         result.wait();
+      }
+      for( auto& result : results ) {
+         result.get();
+      }
+   }
+
+ private:
+   void work( std::stop_token token )
+   {
+      while( true )
+      {
+         std::packaged_task<void()> job{};
+         {
+            std::unique_lock lock{ mutex_ };
+            if( !condition_.wait( lock, token, [this]{ return !jobs_.empty(); } ) ) {
+               return;
+            }
+            job = std::move( jobs_.front() );
+            jobs_.pop();
+         }
+         job();
+      }
+   }
+
+   std::mutex mutex_{};
+   std::condition_variable_any condition_{};
+   std::queue< std::packaged_task<void()> > jobs_{};
+   std::vector<std::jthread> workers_{};  // Declared last, i.e. stopped and joined first
+};
+
+
+//---- <ParallelRanges.h> -------------------------------------------------------------------------
+
+//#include <ranges>
+//#include <ThreadPool.h>
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Parallel counterpart of 'to<>()': 'range | par_to<C>( pool, stages )' splits the range into
+// chunks, applies the given stages (e.g. 'std::views::filter(...) | std::views::transform(...)')
+// to every chunk on a thread of the pool and concatenates the results of all chunks in order.
+// The range is either
+//  - a sized random access range (e.g. a 'std::vector'), which is split into chunks, or
+//  - a segmented range, i.e. a 'join_view' of sized random access ranges (e.g. the vectors of a
+//    'std::map'), whose segments are split into chunks.
+// The stages are applied per chunk instead of splitting an already filtered range, since views
+// such as 'filter_view' cache their 'begin()' and cannot be iterated by several threads. For the
+// same reason, the stages must not depend on the position of an element in the range (e.g.
+// 'take(5)' would take five elements per chunk). Additional arguments are passed to the final
+// container (see 'to<>()'). Random access containers that can be resized (e.g. a 'std::vector')
+// are allocated once and filled by the threads of the pool, all other containers are filled in
+// order by means of 'to<>()'.
+
+namespace detail {
+
+// Below this number of elements per chunk the synchronization dominates the parallel execution
+inline constexpr std::size_t minChunkSize = 16384U;
+
+template< typename R >
+concept Splittable = std::ranges::random_access_range<R> && std::ranges::sized_range<R>;
+
+template< typename C >
+concept Resizable =
+   std::ranges::random_access_range<C> &&
+   std::default_initializable< std::ranges::range_value_t<C> > &&
+   requires( C& c, std::size_t n ) { c.resize( n ); };
+
+template< typename R >
+struct segmented : std::false_type {};
+
+template< typename V >
+   requires ( std::ranges::forward_range<V> && std::copy_constructible<V>
+           && std::is_lvalue_reference_v< std::ranges::range_reference_t<V> >
+           && Splittable< std::ranges::range_reference_t<V> > )
+struct segmented< std::ranges::join_view<V> > : std::true_type {};
+
+template< typename R >
+concept Segmented = segmented< std::remove_cvref_t<R> >::value;
+
+// Splits the given sized random access range into chunks of at most 'size' elements
+template< Splittable R, typename Chunks >
+void split( R&& range, std::size_t size, Chunks& chunks )
+{
+   using Difference = std::ranges::range_difference_t<R>;
+
+   auto const first = std::ranges::begin( range );
+   auto const n = static_cast<std::size_t>( std::ranges::size( range ) );
+
+   for( std::size_t i=0U; i<n; i+=size ) {
+      chunks.emplace_back( first + static_cast<Difference>( i )
+                         , first + static_cast<Difference>( std::min( i+size, n ) ) );
+   }
+}
+
+// Executes 'task(0)', ..., 'task(count-1)' on the pool (a single task is executed directly)
+template< typename Task >
+void run( ThreadPool& pool, std::size_t count, Task const& task )
+{
+   if( count > 1U ) {
+      pool.run( count, task );
+   }
+   else if( count == 1U ) {
+      task( 0U );
+   }
+}
+
+inline std::size_t chunk_size( std::size_t elements, std::size_t threads )
+{
+   return std::max( minChunkSize, ( elements + threads - 1U ) / threads );
+}
+
+template< typename R >
+auto chunks( R& range, std::size_t threads )
+{
+   if constexpr( Segmented<R> )
+   {
+      auto segments = range.base();
+      using Segment = std::ranges::range_reference_t<decltype(segments)>;
+      std::vector< std::ranges::subrange< std::ranges::iterator_t<Segment> > > result{};
+
+      std::size_t elements{};
+      for( auto&& segment : segments ) {
+         elements += static_cast<std::size_t>( std::ranges::size( segment ) );
+      }
+
+      std::size_t const size = chunk_size( elements, threads );
+      for( auto&& segment : segments ) {
+         split( segment, size, result );
+      }
+      return result;
+   }
+   else
+   {
+      std::vector< std::ranges::subrange< std::ranges::iterator_t<R&> > > result{};
+      split( range, chunk_size( static_cast<std::size_t>( std::ranges::size( range ) ), threads ), result );
+      return result;
+   }
+}
+
+} // namespace detail
+
+template< template<typename...> class C, typename Stages, typename... Args >
+struct par_to_range
+{
+   ThreadPool* pool;
+   Stages stages;
+   std::tuple<Args...> args;
+};
+
+template< template<typename...> class C, typename R, typename Stages, typename... Args >
+   requires ( detail::Splittable<R> || detail::Segmented<R> )
+auto par_to( R&& range, ThreadPool& pool, Stages const& stages, Args&&... args )
+{
+   auto const chunks = detail::chunks( range, pool.size() );
+
+   // Every chunk is materialized into its own vector, i.e. no synchronization between the
+   // threads is required
+   using Partial = decltype( chunks.front() | stages | to<std::vector>() );
+   std::vector<Partial> partial( chunks.size() );
+
+   detail::run( pool, chunks.size(), [&]( std::size_t c ){
+      partial[c] = chunks[c] | stages | to<std::vector>();
+   } );
+
+   // The prefix sums of the per-chunk counts are the offsets of the partial results within the
+   // result, which is therefore allocated once
+   std::vector<std::size_t> offsets( partial.size()+1U );
+   std::transform_inclusive_scan( begin(partial), end(partial), begin(offsets)+1, std::plus<>{}
+                                , []( Partial const& p ){ return p.size(); } );
+
+   using Result = detail::container_t< C, std::ranges::range_value_t<Partial>, Args... >;
+
+   if constexpr( detail::Resizable<Result> )
+   {
+      // Every partial result is moved into its own slot, i.e. in parallel
+      Result result( std::forward<Args>(args)... );
+      result.resize( offsets.back() );
+
+      using Difference = std::ranges::range_difference_t<Result>;
+      detail::run( pool, partial.size(), [&]( std::size_t c ){
+         std::ranges::move( partial[c], std::ranges::begin(result) + static_cast<Difference>( offsets[c] ) );
+      } );
+
+      return result;
+   }
+   else
+   {
+      return to<C>( std::views::join( std::move(partial) ), size_hint{ offsets.back() }
+                  , std::forward<Args>(args)... );
+   }
+}
+
+template< template<typename...> class C, typename Stages = std::remove_cv_t<decltype(std::views::all)>, typename... Args >
+auto par_to( ThreadPool& pool, Stages stages = std::views::all, Args&&... args )
+{
+   return par_to_range< C, Stages, std::decay_t<Args>... >{ &pool, std::move(stages), { std::forward<Args>(args)... } };
+}
+
+template< std::ranges::input_range R, template<typename...> class C, typename Stages, typename... Args >
+auto operator|( R&& range, par_to_range<C,Stages,Args...> const& adaptor )
+{
+   return std::apply( [&range,&adaptor]( auto const&... args ){
+                         return par_to<C>( std::forward<R>(range), *adaptor.pool, adaptor.stages, args... ); }
+                    , adaptor.args );
 }
 
 
@@ -105,6 +515,7 @@ struct Continent
 //---- <Main.cpp> ---------------------------------------------------------------------------------
 
 //#include <Continent.h>
+//#include <ParallelRanges.h>
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
@@ -243,6 +654,28 @@ void print_countries()
    for( auto const& country : five_biggest_countries ) {
       std::cout << country << '\n';
    }
+
+
+   // C++20 ranges solution (parallel): the countries of all continents are split into chunks,
+   // which are materialized by the threads of the pool (for a few countries, one chunk suffices)
+   /*
+   ThreadPool pool{};
+
+   auto countries = continents
+                  | std::views::transform( to_countries() )
+                  | std::views::join
+                  | par_to<std::vector>( pool );
+
+   std::ranges::nth_element( countries, begin(countries)+4, is_larger() );
+
+   auto five_biggest_countries = countries | std::views::take(5);
+
+   std::ranges::sort( five_biggest_countries, is_more_populated() );
+
+   for( auto const& country : five_biggest_countries ) {
+      std::cout << country << '\n';
+   }
+   */
 }
 
 int main()
@@ -19,32 +19,177 @@
 //---- <ranges> -----------------------------------------------------------------------------------
 
 #include <concepts>
+#include <cstddef>
+#include <memory>
 #include <ranges>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+
+// Simplified implementation of C++23 'std::ranges::to<>()'. The elements are appended one by one
+// after reserving the required capacity (if the container provides a 'reserve()' function):
+//  - for sized ranges, the capacity is given by the size of the range
+//  - for unsized ranges, an explicit 'size_hint' can be given (e.g. an estimate or upper bound)
+//  - for unsized forward ranges, 'two_pass' counts the elements in a first pass (i.e. all views
+//    are evaluated twice, but the container allocates only once)
+// The elements of owning rvalue ranges (e.g. a temporary container, or a filtered temporary
+// container) are moved instead of copied. Additional arguments (e.g. an allocator or a
+// 'std::pmr::memory_resource') are passed to the constructor of the container.
+
+// The expected number of elements of an unsized range
+struct size_hint
+{
+   std::size_t value{};
+};
+
+// Request to count the elements of a forward range before materializing it
+struct two_pass_t
+{
+   explicit two_pass_t() = default;
+};
+
+inline constexpr two_pass_t two_pass{};
+
+namespace detail {
+
+template< typename C >
+concept Reservable = requires( C& c, std::size_t n ) { c.reserve( n ); };
+
+template< typename A >
+concept Allocator = requires( A& a, std::size_t n ) {
+   typename A::value_type;
+   a.allocate( n );
+};
+
+// The container type: 'C<T>', or 'C<T,Alloc>' for an allocator that is not usable for 'C<T>'
+template< template<typename...> class C, typename T, typename... Args >
+struct container
+{
+   using type = C<T>;
+};
+
+template< template<typename...> class C, typename T, typename A >
+   requires ( Allocator<A> && !std::constructible_from<C<T>,A const&> )
+struct container<C,T,A>
+{
+   using type = C< T, typename std::allocator_traits<A>::template rebind_alloc<T> >;
+};
+
+template< template<typename...> class C, typename T, typename... Args >
+using container_t = typename container<C,T,std::remove_cvref_t<Args>...>::type;
+
+// Ranges that own their elements: containers (i.e. non-view ranges), 'owning_view' and all
+// views that preserve the identity of the elements of an owning range
+template< typename R >
+constexpr bool owns_elements_v = !std::ranges::view<R>;
+
+template< typename R >
+constexpr bool owns_elements_v< std::ranges::owning_view<R> > = true;
+
+template< typename V, typename P >
+constexpr bool owns_elements_v< std::ranges::filter_view<V,P> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::take_view<V> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::drop_view<V> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::reverse_view<V> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::common_view<V> > = owns_elements_v<V>;
+
+template< typename V >
+constexpr bool owns_elements_v< std::ranges::join_view<V> > = owns_elements_v<V>;
 
-// Simplified implementation of C++23 'std::ranges::to<>()'
-template< template<typename...> class C >
+// The elements of an rvalue of an owning range can be moved (as 'std::views::as_rvalue' would)
+template< typename R >
+concept MovableElements = !std::is_lvalue_reference_v<R> && owns_elements_v< std::remove_cvref_t<R> >;
+
+template< typename C, typename T >
+constexpr void append( C& c, T&& value )
+{
+   if constexpr( requires { c.push_back( std::forward<T>(value) ); } ) {
+      c.push_back( std::forward<T>(value) );
+   }
+   else {
+      c.insert( c.end(), std::forward<T>(value) );
+   }
+}
+
+template< typename T >
+constexpr bool is_strategy_v = std::same_as<T,size_hint> || std::same_as<T,two_pass_t>;
+
+} // namespace detail
+
+template< template<typename...> class C, typename... Args >
 struct to_range
-{};
+{
+   std::tuple<Args...> args;
+};
 
-template< template<typename...> class C, std::ranges::input_range R >
-constexpr auto to( R&& range )
+template< template<typename...> class C, std::ranges::input_range R, typename... Args >
+constexpr auto to( R&& range, size_hint hint, Args&&... args )
 {
    using T = std::ranges::range_value_t<R>;
    static_assert( !std::is_reference_v<T> );
-   return C<T>( std::ranges::begin(range), std::ranges::end(range) );
+
+   detail::container_t<C,T,Args...> result( std::forward<Args>(args)... );
+
+   if constexpr( detail::Reservable<decltype(result)> )
+   {
+      std::size_t capacity{ hint.value };
+      if constexpr( std::ranges::sized_range<R> ) {
+         capacity = static_cast<std::size_t>( std::ranges::size(range) );
+      }
+      if( capacity > 0U ) {
+         result.reserve( capacity );
+      }
+   }
+
+   if constexpr( detail::MovableElements<R> ) {
+      for( auto it=std::ranges::begin(range); it!=std::ranges::end(range); ++it ) {
+         detail::append( result, std::ranges::iter_move(it) );
+      }
+   }
+   else {
+      for( auto&& value : range ) {
+         detail::append( result, std::forward<decltype(value)>(value) );
+      }
+   }
+
+   return result;
+}
+
+template< template<typename...> class C, std::ranges::forward_range R, typename... Args >
+constexpr auto to( R&& range, two_pass_t, Args&&... args )
+{
+   auto const size = std::ranges::distance( range );
+   return to<C>( std::forward<R>(range), size_hint{ static_cast<std::size_t>( size ) }
+               , std::forward<Args>(args)... );
+}
+
+template< template<typename...> class C, std::ranges::input_range R, typename... Args >
+   requires ( !detail::is_strategy_v< std::remove_cvref_t<Args> > && ... )
+constexpr auto to( R&& range, Args&&... args )
+{
+   return to<C>( std::forward<R>(range), size_hint{}, std::forward<Args>(args)... );
 }
 
-template< template<typename...> class C >
-constexpr auto to()
+template< template<typename...> class C, typename... Args >
+   requires ( !std::ranges::range< std::remove_cvref_t<Args> > && ... )
+constexpr auto to( Args&&... args )
 {
-   return to_range<C>{};
+   return to_range< C, std::decay_t<Args>... >{ { std::forward<Args>(args)... } };
 }
 
-template< std::ranges::input_range R, template<typename...> class C >
-constexpr auto operator|( R&& range, to_range<C> )
+template< std::ranges::input_range R, template<typename...> class C, typename... Args >
+constexpr auto operator|( R&& range, to_range<C,Args...> const& adaptor )
 {
-   return to<C>(range);
+   return std::apply( [&range]( auto const&... args ){ return to<C>( std::forward<R>(range), args... ); }
+                    , adaptor.args );
 }
 
 
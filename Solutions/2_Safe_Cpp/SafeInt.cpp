@@ -0,0 +1,616 @@
+/**************************************************************************************************
+*
+* \file SafeInt.cpp
+* \brief C++ Training - Programming example about safe integral types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: The 'Count.cpp' and 'IntegralShift.cpp' examples demonstrate how easily the rules for
+*       built-in integral types lead to bugs and undefined behavior. Provide a 'safe_int<T,Policy>'
+*       class template, which
+*        - does not compile for arithmetic operations on operands of different signedness
+*        - only allows implicit, lossless conversions (lossy conversions have to be explicit
+*          and are checked)
+*        - compares values of different signedness correctly
+*        - checks the results of all arithmetic operations and shifts (including shifts by
+*          negative or too large shift counts)
+*       The reaction to a violation is determined by the policy:
+*        - 'ThrowOnViolation': throws a 'std::overflow_error' exception (in constant expressions
+*          this results in a compilation error)
+*        - 'Saturate': results in the closest representable value
+*        - 'Wrap': well-defined two's complement wrap-around (shift counts modulo the width,
+*          'x / 0' results in 0 and 'x % 0' in 'x')
+*       All checks are computed without branches, so loops on 'Saturate' and 'Wrap' integers
+*       can still be vectorized.
+*
+* Step 1: Compare the runtime of the raw and the safe integral types (for instance with
+*         '-O3 -march=native').
+*
+* Step 2: Extend 'safe_int' by division and modulo operations. Note that these have two
+*         different kinds of violations.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <SafeIntegral.h> ---------------------------------------------------------------------------
+
+#include <concepts>
+#include <limits>
+#include <type_traits>
+
+// All integral types except for 'bool' and the character types (which are also excluded from
+// the 'std::cmp_*' functions)
+template< typename T >
+concept SafeIntegral =
+   std::integral<T> &&
+   !std::same_as<std::remove_cv_t<T>,bool> &&
+   !std::same_as<std::remove_cv_t<T>,char> &&
+   !std::same_as<std::remove_cv_t<T>,wchar_t> &&
+   !std::same_as<std::remove_cv_t<T>,char8_t> &&
+   !std::same_as<std::remove_cv_t<T>,char16_t> &&
+   !std::same_as<std::remove_cv_t<T>,char32_t>;
+
+// A conversion from 'From' to 'To' is value preserving if every value of 'From' can be
+// represented by 'To' (note that 'digits' doesn't include the sign bit)
+template< typename From, typename To >
+concept ValuePreserving =
+   SafeIntegral<From> && SafeIntegral<To> &&
+   ( std::is_unsigned_v<From> || std::is_signed_v<To> ) &&
+   std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits;
+
+
+//---- <OverflowPolicy.h> -------------------------------------------------------------------------
+
+#include <stdexcept>
+
+// An overflow policy decides how to react to an operation that violates the range of the
+// integral type. 'value' is the result with two's complement wrap-around, 'valid' the result of
+// the check and 'closest' the representable value that is closest to the exact result.
+struct ThrowOnViolation
+{
+   template< typename T >
+   static constexpr void enforce( T& /*value*/, bool valid, T const& /*closest*/, char const* message )
+   {
+      if( !valid ) [[unlikely]] {
+         throw std::overflow_error( message );
+      }
+   }
+};
+
+struct Saturate
+{
+   template< typename T >
+   static constexpr void enforce( T& value, bool valid, T const& closest, char const* /*message*/ ) noexcept
+   {
+      value = valid ? value : closest;  // Select instead of branch
+   }
+};
+
+struct Wrap
+{
+   template< typename T >
+   static constexpr void enforce( T& /*value*/, bool /*valid*/, T const& /*closest*/, char const* /*message*/ ) noexcept
+   {}
+};
+
+
+//---- <SafeArithmetic.h> -------------------------------------------------------------------------
+
+//#include <SafeIntegral.h>
+#include <climits>
+#include <limits>
+#include <utility>
+
+// All operations compute the wrapped result, the validity of the result and the closest
+// representable value without branches. Note that '__builtin_add_overflow()' and friends would
+// prevent vectorization (at least for GCC).
+namespace detail {
+
+template< SafeIntegral T >
+struct Checked
+{
+   T value;
+   bool valid;
+   T closest;
+};
+
+// The closest representable value for an exact result beyond the range of 'T'
+template< SafeIntegral T >
+constexpr T saturated( bool negative ) noexcept
+{
+   return negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+}
+
+template< SafeIntegral T >
+constexpr Checked<T> add( T a, T b ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   T const result = static_cast<T>( static_cast<U>(a) + static_cast<U>(b) );
+
+   if constexpr( std::is_signed_v<T> ) {
+      return { result, ( ( a ^ result ) & ( b ^ result ) ) >= T{}, saturated<T>( a < T{} ) };
+   }
+   else {
+      return { result, result >= a, std::numeric_limits<T>::max() };
+   }
+}
+
+template< SafeIntegral T >
+constexpr Checked<T> sub( T a, T b ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   T const result = static_cast<T>( static_cast<U>(a) - static_cast<U>(b) );
+
+   if constexpr( std::is_signed_v<T> ) {
+      return { result, ( ( a ^ b ) & ( a ^ result ) ) >= T{}, saturated<T>( a < T{} ) };
+   }
+   else {
+      return { result, a >= b, T{} };
+   }
+}
+
+template< SafeIntegral T >
+constexpr Checked<T> mul( T a, T b ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   T const closest = saturated<T>( ( a < T{} ) != ( b < T{} ) );
+
+   if constexpr( sizeof(T) < sizeof(long long) ) {
+      // The product of two values of 'T' fits into the wider type (note that for 32-bit types
+      // the vectorization requires a 64-bit vector multiplication, e.g. SSE4.1)
+      using W = std::conditional_t< std::is_signed_v<T>, long long, unsigned long long >;
+      W const product = static_cast<W>(a) * static_cast<W>(b);
+      T const result = static_cast<T>( product );
+      return { result, product == static_cast<W>( result ), closest };
+   }
+   else {
+      T const result = static_cast<T>( static_cast<U>(a) * static_cast<U>(b) );
+      if constexpr( std::is_signed_v<T> ) {
+         bool const valid =
+            ( a == T{-1} ) ? ( b != std::numeric_limits<T>::min() ) :
+            ( a == T{} ) || ( result / a == b );
+         return { result, valid, closest };
+      }
+      else {
+         return { result, a == T{} || result / a == b, closest };
+      }
+   }
+}
+
+// Division and modulo have two kinds of violations: a division by zero, which has no result at
+// all, and the overflow of 'min / -1'. The division by zero results in 0 and the modulo by zero
+// in the dividend (i.e. 'a == (a/b)*b + a%b' still holds), the closest value of 'x / 0' is the
+// limit in the direction of 'x'. Note that 'min % -1' is valid (but undefined for 'int').
+template< SafeIntegral T >
+constexpr Checked<T> div( T a, T b ) noexcept
+{
+   bool overflow{ false };
+   if constexpr( std::is_signed_v<T> ) {
+      overflow = ( a == std::numeric_limits<T>::min() ) && ( b == T{-1} );
+   }
+
+   T const divisor = ( b == T{} || overflow ) ? T{1} : b;  // 'min / 1' is the wrapped result
+   T const result = ( b == T{} ) ? T{} : static_cast<T>( a / divisor );
+   T const closest = ( a == T{} ) ? T{} : saturated<T>( ( a < T{} ) != ( b < T{} ) );
+
+   return { result, b != T{} && !overflow, closest };
+}
+
+template< SafeIntegral T >
+constexpr Checked<T> mod( T a, T b ) noexcept
+{
+   bool overflow{ false };
+   if constexpr( std::is_signed_v<T> ) {
+      overflow = ( a == std::numeric_limits<T>::min() ) && ( b == T{-1} );
+   }
+
+   T const divisor = ( b == T{} || overflow ) ? T{1} : b;  // 'min % 1' is the exact result
+   T const result = ( b == T{} ) ? a : static_cast<T>( a % divisor );
+
+   return { result, b != T{}, result };
+}
+
+template< SafeIntegral T >
+constexpr Checked<T> neg( T a ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   T const result = static_cast<T>( U{} - static_cast<U>(a) );
+   return { result, a != std::numeric_limits<T>::min(), std::numeric_limits<T>::max() };
+}
+
+// Shifts by negative counts and by counts of at least the width of 'T' are invalid. The wrapped
+// result uses the shift count modulo the width (as most hardware does).
+template< SafeIntegral T, SafeIntegral C >
+constexpr Checked<T> shl( T a, C count ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   constexpr int width{ std::numeric_limits<U>::digits };
+
+   bool const in_range = std::cmp_greater_equal( count, 0 ) && std::cmp_less( count, width );
+   int const shift = static_cast<int>( static_cast<U>( count ) & U{ width-1 } );
+   T const result = static_cast<T>( static_cast<U>(a) << shift );
+
+   // The shift is valid if no set bit (and for signed types no bit different from the sign bit)
+   // is shifted out, i.e. if shifting back results in the original value
+   bool const valid = in_range && ( result >> shift ) == a;
+   T const closest = ( std::cmp_less( count, 0 ) || a == T{} ) ? a : saturated<T>( a < T{} );
+
+   return { result, valid, closest };
+}
+
+template< SafeIntegral T, SafeIntegral C >
+constexpr Checked<T> shr( T a, C count ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   constexpr int width{ std::numeric_limits<U>::digits };
+
+   bool const in_range = std::cmp_greater_equal( count, 0 ) && std::cmp_less( count, width );
+   int const shift = static_cast<int>( static_cast<U>( count ) & U{ width-1 } );
+   T const result = static_cast<T>( a >> shift );
+   T const closest = std::cmp_less( count, 0 ) ? a : ( a < T{} ) ? T{-1} : T{};
+
+   return { result, in_range, closest };
+}
+
+template< SafeIntegral T, SafeIntegral U >
+constexpr Checked<T> convert( U value ) noexcept
+{
+   return { static_cast<T>( value ), std::in_range<T>( value ), saturated<T>( std::cmp_less( value, 0 ) ) };
+}
+
+} // namespace detail
+
+
+//---- <SafeInt.h> --------------------------------------------------------------------------------
+
+//#include <OverflowPolicy.h>
+//#include <SafeArithmetic.h>
+#include <compare>
+#include <ostream>
+
+template< SafeIntegral T, typename Policy = ThrowOnViolation >
+class safe_int
+{
+ public:
+   using value_type  = T;
+   using policy_type = Policy;
+
+   constexpr safe_int() = default;
+
+   // Lossless conversions are implicit ...
+   template< SafeIntegral U >
+      requires ValuePreserving<U,T>
+   constexpr safe_int( U value ) noexcept
+      : value_( static_cast<T>( value ) )
+   {}
+
+   template< SafeIntegral U >
+      requires ValuePreserving<U,T>
+   constexpr safe_int( safe_int<U,Policy> value ) noexcept
+      : value_( static_cast<T>( value.get() ) )
+   {}
+
+   // ... lossy conversions (and conversions between different policies) are explicit and checked
+   template< SafeIntegral U >
+      requires ( !ValuePreserving<U,T> )
+   explicit constexpr safe_int( U value )
+      : value_( enforce( detail::convert<T>( value ), "Lossy conversion detected" ) )
+   {}
+
+   template< SafeIntegral U, typename P >
+      requires ( !ValuePreserving<U,T> || !std::same_as<P,Policy> )
+   explicit constexpr safe_int( safe_int<U,P> value )
+      : value_( enforce( detail::convert<T>( value.get() ), "Lossy conversion detected" ) )
+   {}
+
+   // Conversions to raw integral types are explicit and only available if lossless
+   template< SafeIntegral U >
+      requires ValuePreserving<T,U>
+   explicit constexpr operator U() const noexcept { return value_; }
+
+   [[nodiscard]] constexpr T get() const noexcept { return value_; }
+
+ private:
+   static constexpr T enforce( detail::Checked<T> checked, char const* message )
+      noexcept( noexcept( Policy::enforce( checked.value, true, checked.closest, message ) ) )
+   {
+      Policy::enforce( checked.value, checked.valid, checked.closest, message );
+      return checked.value;
+   }
+
+   static constexpr safe_int make( detail::Checked<T> checked, char const* message )
+      noexcept( noexcept( enforce( checked, message ) ) )
+   {
+      safe_int result{};
+      result.value_ = enforce( checked, message );
+      return result;
+   }
+
+   T value_{};
+
+   // Arithmetic operations (only for operands of the same signedness, the narrower operand is
+   // implicitly converted)
+   friend constexpr safe_int operator+( safe_int lhs, safe_int rhs )
+   {
+      return make( detail::add( lhs.value_, rhs.value_ ), "Integer overflow detected" );
+   }
+
+   friend constexpr safe_int operator-( safe_int lhs, safe_int rhs )
+   {
+      return make( detail::sub( lhs.value_, rhs.value_ ), "Integer overflow detected" );
+   }
+
+   friend constexpr safe_int operator*( safe_int lhs, safe_int rhs )
+   {
+      return make( detail::mul( lhs.value_, rhs.value_ ), "Integer overflow detected" );
+   }
+
+   friend constexpr safe_int operator/( safe_int lhs, safe_int rhs )
+   {
+      return make( detail::div( lhs.value_, rhs.value_ ),
+                   rhs.value_ == T{} ? "Division by zero detected" : "Integer overflow detected" );
+   }
+
+   friend constexpr safe_int operator%( safe_int lhs, safe_int rhs )
+   {
+      return make( detail::mod( lhs.value_, rhs.value_ ), "Division by zero detected" );
+   }
+
+   friend constexpr safe_int operator-( safe_int value ) requires std::is_signed_v<T>
+   {
+      return make( detail::neg( value.value_ ), "Integer overflow detected" );
+   }
+
+   friend constexpr safe_int operator+( safe_int value ) noexcept { return value; }
+
+   friend constexpr safe_int& operator+=( safe_int& lhs, safe_int rhs ) { return lhs = lhs + rhs; }
+   friend constexpr safe_int& operator-=( safe_int& lhs, safe_int rhs ) { return lhs = lhs - rhs; }
+   friend constexpr safe_int& operator*=( safe_int& lhs, safe_int rhs ) { return lhs = lhs * rhs; }
+   friend constexpr safe_int& operator/=( safe_int& lhs, safe_int rhs ) { return lhs = lhs / rhs; }
+   friend constexpr safe_int& operator%=( safe_int& lhs, safe_int rhs ) { return lhs = lhs % rhs; }
+
+   friend constexpr safe_int& operator++( safe_int& value ) { return value += safe_int{ T{1} }; }
+   friend constexpr safe_int& operator--( safe_int& value ) { return value -= safe_int{ T{1} }; }
+   friend constexpr safe_int operator++( safe_int& value, int ) { auto const tmp{ value }; ++value; return tmp; }
+   friend constexpr safe_int operator--( safe_int& value, int ) { auto const tmp{ value }; --value; return tmp; }
+
+   // Shift operations (the shift count may have any integral type)
+   template< SafeIntegral C >
+   friend constexpr safe_int operator<<( safe_int lhs, C count )
+   {
+      return make( detail::shl( lhs.value_, count ), "Invalid shift detected" );
+   }
+
+   template< SafeIntegral C >
+   friend constexpr safe_int operator>>( safe_int lhs, C count )
+   {
+      return make( detail::shr( lhs.value_, count ), "Invalid shift detected" );
+   }
+
+   template< SafeIntegral C, typename P >
+   friend constexpr safe_int operator<<( safe_int lhs, safe_int<C,P> count ) { return lhs << count.get(); }
+
+   template< SafeIntegral C, typename P >
+   friend constexpr safe_int operator>>( safe_int lhs, safe_int<C,P> count ) { return lhs >> count.get(); }
+
+   template< typename C >
+   friend constexpr safe_int& operator<<=( safe_int& lhs, C count ) { return lhs = lhs << count; }
+
+   template< typename C >
+   friend constexpr safe_int& operator>>=( safe_int& lhs, C count ) { return lhs = lhs >> count; }
+
+   // Bitwise operations (cannot overflow)
+   friend constexpr safe_int operator&( safe_int lhs, safe_int rhs ) noexcept { return make( { static_cast<T>( lhs.value_ & rhs.value_ ), true, T{} }, "" ); }
+   friend constexpr safe_int operator|( safe_int lhs, safe_int rhs ) noexcept { return make( { static_cast<T>( lhs.value_ | rhs.value_ ), true, T{} }, "" ); }
+   friend constexpr safe_int operator^( safe_int lhs, safe_int rhs ) noexcept { return make( { static_cast<T>( lhs.value_ ^ rhs.value_ ), true, T{} }, "" ); }
+
+   // Comparisons with raw and safe integral values, which are correct for operands of different
+   // signedness (in contrast to '-1 < 0U')
+   template< SafeIntegral U >
+   friend constexpr bool operator==( safe_int lhs, U rhs ) noexcept
+   {
+      return std::cmp_equal( lhs.value_, rhs );
+   }
+
+   template< SafeIntegral U >
+   friend constexpr std::strong_ordering operator<=>( safe_int lhs, U rhs ) noexcept
+   {
+      return std::cmp_less( lhs.value_, rhs )  ? std::strong_ordering::less
+           : std::cmp_equal( lhs.value_, rhs ) ? std::strong_ordering::equal
+                                               : std::strong_ordering::greater;
+   }
+
+   template< SafeIntegral U, typename P >
+   friend constexpr bool operator==( safe_int lhs, safe_int<U,P> rhs ) noexcept
+   {
+      return lhs == rhs.get();
+   }
+
+   template< SafeIntegral U, typename P >
+   friend constexpr std::strong_ordering operator<=>( safe_int lhs, safe_int<U,P> rhs ) noexcept
+   {
+      return lhs <=> rhs.get();
+   }
+
+   friend std::ostream& operator<<( std::ostream& os, safe_int value )
+   {
+      return os << +value.value_;
+   }
+};
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+template< typename A, typename B >
+concept SubtractableWith = requires( A a, B b ){ a - b; };
+
+template< typename A, typename B >
+concept ImplicitlyConvertible = std::is_convertible_v<A,B>;
+
+// The 'count()' function of 'Count.cpp': the mixed-sign subtraction 'size - i' doesn't compile,
+// with an unsigned loop variable the subtraction is checked and throws instead of wrapping
+std::uint64_t count( safe_int<std::uint64_t> size )
+{
+   std::uint64_t count{};
+
+   for( safe_int<std::uint64_t> i{}; size-i >= 0; ++i ) {
+      ++count;
+   }
+
+   return count;
+}
+
+// The 'shift()' function of 'IntegralShift.cpp': the shift is performed on the 64-bit type
+// (and a shift by 64 or more would be detected)
+std::uint64_t shift( std::uint64_t count )
+{
+   return ( safe_int<std::uint64_t>{ 1U } << ( count % 64U ) ).get();
+}
+
+int main()
+{
+   using i8  = safe_int<std::int8_t>;
+   using i32 = safe_int<std::int32_t>;
+   using u32 = safe_int<std::uint32_t>;
+   using u64 = safe_int<std::uint64_t>;
+
+   // Compile time checks
+   {
+      static_assert(  ImplicitlyConvertible< std::int8_t, i32 > );    // Lossless
+      static_assert(  ImplicitlyConvertible< std::uint16_t, i32 > );  // Lossless
+      static_assert( !ImplicitlyConvertible< std::int64_t, i32 > );   // Lossy: explicit only
+      static_assert( !ImplicitlyConvertible< int, i8 > );             // Lossy: explicit only
+      static_assert( !ImplicitlyConvertible< int, u64 > );            // Sign change: explicit only
+      static_assert( !ImplicitlyConvertible< i32, int > );            // Explicit 'static_cast'
+
+      static_assert(  SubtractableWith< i32, safe_int<std::int64_t> > );  // Result: 64-bit
+      static_assert( !SubtractableWith< u64, int > );
+      static_assert( !SubtractableWith< u64, i32 > );
+      static_assert( !SubtractableWith< safe_int<int,Wrap>, safe_int<int,Saturate> > );
+
+      static_assert( i32{ -1 } < u32{ 0U } );  // Correct mixed-sign comparisons
+      static_assert( i32{ -1 } != 0xFFFFFFFFU );
+      static_assert( u64{ 1U } << 63 == 0x8000000000000000U );
+
+      static_assert( safe_int<std::int8_t,Saturate>{ 300 } == 127 );
+      static_assert( safe_int<std::int8_t,Saturate>{ 100 } * std::int8_t{ -2 } == -128 );
+      static_assert( safe_int<std::uint8_t,Wrap>{ 200U } + std::uint8_t{ 100U } == 44 );
+      static_assert( safe_int<int,Saturate>{ 1 } << 40 == std::numeric_limits<int>::max() );
+      static_assert( safe_int<int,Wrap>{ 1 } << 33 == 2 );
+      static_assert( safe_int<int,Saturate>{ -8 } >> 40 == -1 );
+      static_assert( safe_int<int,Saturate>{ INT_MIN } / -1 == INT_MAX );
+      static_assert( safe_int<int,Saturate>{ -7 } / 0 == INT_MIN );
+      static_assert( safe_int<int,Wrap>{ INT_MIN } / -1 == INT_MIN );
+      static_assert( safe_int<int,Wrap>{ 7 } / 0 == 0 );
+      static_assert( safe_int<int,Wrap>{ 7 } % 0 == 7 );
+      static_assert( i32{ INT_MIN } % -1 == 0 );
+      static_assert( i32{ -7 } / 2 == -3 && i32{ -7 } % 2 == -1 );
+
+      //constexpr i8 a{ 300 };                   // Does not compile (lossy conversion)
+      //constexpr i32 b{ i32{ 1 } << 32 };       // Does not compile (invalid shift)
+      //constexpr u32 c{ u32{ 1U } - 2U };       // Does not compile (overflow)
+      //constexpr i32 d{ std::numeric_limits<int>::max() };  constexpr auto e = d + 1;  // Does not compile
+      //constexpr i32 f{ i32{ 1 } / 0 };         // Does not compile (division by zero)
+   }
+
+   // The examples of 'Count.cpp' and 'IntegralShift.cpp'
+   {
+      try {
+         auto const result = count( 3U );
+         std::cout << "\n count(3) = " << result << "\n";
+      }
+      catch( std::overflow_error const& ex ) {
+         std::cout << "\n count(3): " << ex.what() << "\n";
+      }
+
+      std::cout << " shift(31) = " << shift( 31U ) << "\n"
+                << " shift(32) = " << shift( 32U ) << "\n";
+
+      try {
+         auto const result = u64{ 1U } << 64;
+         std::cout << " 1 << 64 = " << result << "\n";
+      }
+      catch( std::overflow_error const& ex ) {
+         std::cout << " 1 << 64: " << ex.what() << "\n";
+      }
+
+      for( i32 const divisor : { i32{ 0 }, i32{ -1 } } ) {
+         try {
+            auto const result = i32{ INT_MIN } / divisor;
+            std::cout << " INT_MIN / " << divisor << " = " << result << "\n";
+         }
+         catch( std::overflow_error const& ex ) {
+            std::cout << " INT_MIN / " << divisor << ": " << ex.what() << "\n";
+         }
+      }
+   }
+
+   // Runtime of a tight loop: c[i] = a[i] * 3 + b[i]
+   {
+      constexpr std::size_t N = 10000U;
+      constexpr std::size_t repetitions = 20000U;
+
+      std::mt19937 rng{ std::random_device{}() };
+      std::uniform_int_distribution<std::int32_t> dist{ -1000000, 1000000 };
+
+      std::vector<std::int32_t> a_raw( N ), b_raw( N );
+      std::generate( begin(a_raw), end(a_raw), [&]{ return dist(rng); } );
+      std::generate( begin(b_raw), end(b_raw), [&]{ return dist(rng); } );
+
+      auto const benchmark = [&]<typename Int>( Int ) {
+         std::vector<Int> a( begin(a_raw), end(a_raw) );
+         std::vector<Int> b( begin(b_raw), end(b_raw) );
+         std::vector<Int> c( N );
+         Int const factor{ 3 };
+
+         double const seconds = measure( [&]{
+            for( std::size_t r=0U; r<repetitions; ++r ) {
+               for( std::size_t i=0U; i<N; ++i ) {
+                  c[i] = a[i] * factor + b[i];
+               }
+               std::swap( a, b );
+            }
+         } ) / repetitions;
+
+         return std::pair{ seconds, static_cast<std::int64_t>( c[N/2U] ) };
+      };
+
+      auto const [seconds_raw, checksum_raw] = benchmark( std::int32_t{} );
+      auto const [seconds_wrap, checksum_wrap] = benchmark( safe_int<std::int32_t,Wrap>{} );
+      auto const [seconds_saturate, checksum_saturate] = benchmark( safe_int<std::int32_t,Saturate>{} );
+      auto const [seconds_throw, checksum_throw] = benchmark( safe_int<std::int32_t,ThrowOnViolation>{} );
+
+      std::cout << "\n Runtime of 'c[i] = a[i] * 3 + b[i]' on " << N << " values:"
+                << "\n  int32_t (unchecked)        : " << seconds_raw*1E6 << "us (checksum=" << checksum_raw << ")"
+                << "\n  safe_int<int32_t,Wrap>     : " << seconds_wrap*1E6 << "us (checksum=" << checksum_wrap << ")"
+                << "\n  safe_int<int32_t,Saturate> : " << seconds_saturate*1E6 << "us (checksum=" << checksum_saturate << ")"
+                << "\n  safe_int<int32_t,Throw...> : " << seconds_throw*1E6 << "us (checksum=" << checksum_throw << ")\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -132,8 +132,7 @@ class StrongType final
 
    friend std::ostream& operator<<( std::ostream& os, StrongType const& s )  // Hidden friend
    {
-      os << s.get();
-      return os;
+      return os << s.get();
    }
 
    template< typename T_, typename Tag_ >
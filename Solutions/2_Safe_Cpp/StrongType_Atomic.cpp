@@ -0,0 +1,417 @@
+/**************************************************************************************************
+*
+* \file StrongType_Atomic.cpp
+* \brief C++ Training - Programming example about lock-free concurrent updates of strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Several threads accumulate distances of type 'Meter<long>'. In order to update the total
+*       distance concurrently, the strong type is currently unwrapped into a 'std::atomic<long>',
+*       which loses all type safety. Provide
+*        - an 'AtomicStrongType<S>' class template, which provides lock-free 'load()', 'store()',
+*          'exchange()' and compare-and-swap operations for the strong type 'S' and additionally
+*          'fetch_add()' and 'fetch_sub()' in case 'S' is 'Addable' or 'Subtractable'
+*        - a 'ShardedCounter<S>' class template, which distributes the updates of several threads
+*          to separate cache lines in order to avoid contention on hot counters
+*
+* Step 1: Compare the runtime of concurrent updates of a single atomic and a sharded counter.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      return os << d.get();
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <HasSkill.h> -------------------------------------------------------------------------------
+
+// Checks whether the strong type 'S' provides the given skill (directly or via a compound skill)
+template< typename S, template<typename...> class Skill >
+concept HasSkill = std::derived_from< S, Skill<S> >;
+
+
+//---- <AtomicStrongType.h> -----------------------------------------------------------------------
+
+//#include <HasSkill.h>
+#include <atomic>
+
+template< typename S >
+concept AtomicCompatible =
+   std::is_trivially_copyable_v<typename S::value_type> &&
+   std::atomic<typename S::value_type>::is_always_lock_free;
+
+// Lock-free atomic strong type. In contrast to 'std::atomic<S>', all operations are performed
+// on the underlying value, i.e. 'fetch_add()' and 'fetch_sub()' use the according hardware
+// instructions instead of a compare-and-swap loop. Both are only available if the strong type
+// provides the according arithmetic skill.
+template< AtomicCompatible S >
+class AtomicStrongType
+{
+ public:
+   using value_type = S;
+   using underlying_type = typename S::value_type;
+
+   static constexpr bool is_always_lock_free = true;
+
+   constexpr AtomicStrongType() noexcept = default;
+   constexpr explicit AtomicStrongType( S desired ) noexcept : value_{ desired.get() } {}
+
+   AtomicStrongType( AtomicStrongType const& ) = delete;
+   AtomicStrongType& operator=( AtomicStrongType const& ) = delete;
+
+   S load( std::memory_order order = std::memory_order_seq_cst ) const noexcept
+   {
+      return S{ value_.load( order ) };
+   }
+
+   void store( S desired, std::memory_order order = std::memory_order_seq_cst ) noexcept
+   {
+      value_.store( desired.get(), order );
+   }
+
+   S exchange( S desired, std::memory_order order = std::memory_order_seq_cst ) noexcept
+   {
+      return S{ value_.exchange( desired.get(), order ) };
+   }
+
+   bool compare_exchange_weak( S& expected, S desired,
+                               std::memory_order order = std::memory_order_seq_cst ) noexcept
+   {
+      return value_.compare_exchange_weak( expected.get(), desired.get(), order );
+   }
+
+   bool compare_exchange_strong( S& expected, S desired,
+                                 std::memory_order order = std::memory_order_seq_cst ) noexcept
+   {
+      return value_.compare_exchange_strong( expected.get(), desired.get(), order );
+   }
+
+   S fetch_add( S arg, std::memory_order order = std::memory_order_seq_cst ) noexcept
+      requires HasSkill<S,Addable>
+   {
+      return S{ value_.fetch_add( arg.get(), order ) };
+   }
+
+   S fetch_sub( S arg, std::memory_order order = std::memory_order_seq_cst ) noexcept
+      requires HasSkill<S,Subtractable>
+   {
+      return S{ value_.fetch_sub( arg.get(), order ) };
+   }
+
+   S operator+=( S arg ) noexcept requires HasSkill<S,Addable>
+   {
+      return S{ value_.fetch_add( arg.get() ) + arg.get() };
+   }
+
+   S operator-=( S arg ) noexcept requires HasSkill<S,Subtractable>
+   {
+      return S{ value_.fetch_sub( arg.get() ) - arg.get() };
+   }
+
+ private:
+   std::atomic<underlying_type> value_{};
+};
+
+
+//---- <ShardedCounter.h> -------------------------------------------------------------------------
+
+//#include <AtomicStrongType.h>
+#include <array>
+#include <cstddef>
+#include <new>
+
+#if defined(__cpp_lib_hardware_interference_size)
+inline constexpr std::size_t cacheLineSize = std::hardware_destructive_interference_size;
+#else
+inline constexpr std::size_t cacheLineSize = 64U;
+#endif
+
+namespace detail {
+
+// Every thread is assigned to a fixed shard in a round robin fashion
+inline std::size_t thread_index() noexcept
+{
+   static std::atomic<std::size_t> next{ 0U };
+   thread_local std::size_t const index{ next.fetch_add( 1U, std::memory_order_relaxed ) };
+   return index;
+}
+
+} // namespace detail
+
+// Counter for frequent concurrent updates and rare reads. Every shard is placed in a separate
+// cache line, i.e. threads updating different shards do not compete for the same cache line.
+// Reading the counter sums up all shards, which is not an atomic snapshot of concurrent updates.
+template< typename S, std::size_t Shards = 16U >
+   requires HasSkill<S,Addable>
+class ShardedCounter
+{
+ public:
+   void add( S value ) noexcept
+   {
+      shards_[detail::thread_index() % Shards].value.fetch_add( value, std::memory_order_relaxed );
+   }
+
+   void subtract( S value ) noexcept requires HasSkill<S,Subtractable>
+   {
+      shards_[detail::thread_index() % Shards].value.fetch_sub( value, std::memory_order_relaxed );
+   }
+
+   S load() const noexcept
+   {
+      S sum{};
+      for( Shard const& shard : shards_ ) {
+         sum += shard.value.load( std::memory_order_relaxed );
+      }
+      return sum;
+   }
+
+ private:
+   struct alignas(cacheLineSize) Shard
+   {
+      AtomicStrongType<S> value{};
+   };
+
+   std::array<Shard,Shards> shards_{};
+};
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+template< typename T >
+using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Printable,EqualityComparable>;
+
+template< typename T >
+using Count = StrongType<T,struct CountTag,Addable,Printable,EqualityComparable>;
+
+template< typename T >
+using Name = StrongType<T,struct NameTag,Printable,EqualityComparable>;
+
+template< typename S >
+concept SupportsFetchAdd = requires ( AtomicStrongType<S> a, S s ) { a.fetch_add( s ); };
+
+template< typename S >
+concept SupportsFetchSub = requires ( AtomicStrongType<S> a, S s ) { a.fetch_sub( s ); };
+
+static_assert( SupportsFetchAdd< Meter<long> > && SupportsFetchSub< Meter<long> > );
+static_assert( SupportsFetchAdd< Count<long> > && !SupportsFetchSub< Count<long> > );
+static_assert( !SupportsFetchAdd< Name<long> > && !SupportsFetchSub< Name<long> > );
+static_assert( sizeof(AtomicStrongType< Meter<long> >) == sizeof(std::atomic<long>) );
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+// Runs the given update function concurrently on the given number of threads
+template< typename Update >
+double concurrently( std::size_t threads, std::size_t updates, Update update )
+{
+   return measure( [&]{
+      std::vector<std::jthread> workers{};
+      workers.reserve( threads );
+      for( std::size_t t=0U; t<threads; ++t ) {
+         workers.emplace_back( [=]{
+            for( std::size_t i=0U; i<updates; ++i ) {
+               update();
+            }
+         } );
+      }
+   } );
+}
+
+int main()
+{
+   // Type safe atomic operations
+   {
+      AtomicStrongType< Meter<long> > total{ Meter<long>{ 100L } };
+
+      total.fetch_add( Meter<long>{ 50L } );
+      total -= Meter<long>{ 20L };
+
+      Meter<long> expected{ total.load() };
+      while( !total.compare_exchange_weak( expected, expected + expected ) ) {}
+
+      std::cout << "\n total = " << total.load() << "m\n";
+   }
+
+   // Contention benchmark
+   {
+      std::size_t const threads{ std::max( 4U, std::thread::hardware_concurrency() ) };
+      constexpr std::size_t updates{ 2000000U };
+
+      std::atomic<long> raw{};
+      AtomicStrongType< Meter<long> > atomic{};
+      ShardedCounter< Meter<long> > sharded{};
+
+      double const seconds_raw = concurrently( threads, updates, [&]{
+         raw.fetch_add( 1L, std::memory_order_relaxed );
+      } );
+
+      double const seconds_atomic = concurrently( threads, updates, [&]{
+         atomic.fetch_add( Meter<long>{ 1L }, std::memory_order_relaxed );
+      } );
+
+      double const seconds_sharded = concurrently( threads, updates, [&]{
+         sharded.add( Meter<long>{ 1L } );
+      } );
+
+      std::cout << "\n " << threads << " threads with " << updates << " updates each:"
+                << "\n  std::atomic<long>:        " << seconds_raw*1E3 << "ms (total = " << raw.load() << ")"
+                << "\n  AtomicStrongType<Meter>:  " << seconds_atomic*1E3 << "ms (total = " << atomic.load() << "m)"
+                << "\n  ShardedCounter<Meter>:    " << seconds_sharded*1E3 << "ms (total = " << sharded.load() << "m)"
+                << "\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
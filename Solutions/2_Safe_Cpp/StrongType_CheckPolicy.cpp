@@ -0,0 +1,382 @@
+/**************************************************************************************************
+*
+* \file StrongType_CheckPolicy.cpp
+* \brief C++ Training - Programming example about selectable check policies for strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: The 'Positive' skill checks every new value of a strong type and throws an exception in
+*       case of a negative value. In inner loops this costs a branch per operation and prevents
+*       vectorization. Make the reaction to a violated invariant selectable, both per type and
+*       per build (via the 'STRONGTYPE_CHECK_POLICY' macro):
+*        - 'ThrowOnViolation': throws a 'std::invalid_argument' exception (the default)
+*        - 'AssertOnViolation': checks via 'assert()', i.e. no check in release builds
+*        - 'AssumeValid': no check, but the invariant is passed to the optimizer (if possible)
+*        - 'Saturate': violating values are clamped to the closest valid value
+*
+* Step 1: Compare the runtime of the 'add()' kernel for all check policies.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( Derived{ lhs.get() + rhs.get() } ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( Derived{ lhs.get() - rhs.get() } ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      return os << d.get();
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <CheckPolicy.h> ---------------------------------------------------------------------------
+
+#include <cassert>
+#include <stdexcept>
+
+// Tells the optimizer that the given condition holds (undefined behavior otherwise). GCC
+// offers no assumption before '[[assume]]' (GCC 13): the '__builtin_unreachable()' idiom keeps
+// the condition as a branch in loops and prevents their vectorization. Therefore the condition
+// is ignored on this toolchain.
+constexpr void assume( bool condition ) noexcept
+{
+#if defined(__has_cpp_attribute) && __has_cpp_attribute(assume)
+   [[assume( condition )]];
+#elif defined(__clang__)
+   __builtin_assume( condition );
+#elif defined(_MSC_VER)
+   __assume( condition );
+#else
+   static_cast<void>( condition );
+#endif
+}
+
+// A check policy decides how to react to a value that violates the invariant of a strong type.
+// 'value' is the new value, 'valid' the result of the check and 'closest' the valid value that
+// is closest to 'value'.
+struct ThrowOnViolation
+{
+   template< typename T >
+   static constexpr void enforce( T& /*value*/, bool valid, T const& /*closest*/, char const* message )
+   {
+      if( !valid ) {
+         throw std::invalid_argument( message );
+      }
+   }
+};
+
+struct AssertOnViolation
+{
+   template< typename T >
+   static constexpr void enforce( T& /*value*/, bool valid, T const& /*closest*/, char const* message ) noexcept
+   {
+      assert( valid && message );
+      static_cast<void>( valid );
+      static_cast<void>( message );
+   }
+};
+
+struct AssumeValid
+{
+   template< typename T >
+   static constexpr void enforce( T& /*value*/, bool valid, T const& /*closest*/, char const* /*message*/ ) noexcept
+   {
+      assume( valid );
+   }
+};
+
+struct Saturate
+{
+   template< typename T >
+   static constexpr void enforce( T& value, bool valid, T const& closest, char const* /*message*/ ) noexcept
+   {
+      if( !valid ) {
+         value = closest;
+      }
+   }
+};
+
+// The default policy can be selected per build, e.g. '-DSTRONGTYPE_CHECK_POLICY=AssumeValid'
+#if defined(STRONGTYPE_CHECK_POLICY)
+using DefaultCheckPolicy = STRONGTYPE_CHECK_POLICY;
+#else
+using DefaultCheckPolicy = ThrowOnViolation;
+#endif
+
+
+//---- <Positive.h> -------------------------------------------------------------------------------
+
+//#include <CheckPolicy.h>
+
+template< typename Derived, typename Policy = DefaultCheckPolicy >
+struct Positive
+{
+   template< typename T >
+   constexpr void checkValue( T& value ) const
+      noexcept( noexcept( Policy::enforce( value, true, value, "" ) ) )
+   {
+      Policy::enforce( value, !( value < T{} ), T{}, "Negative value detected" );
+   }
+};
+
+// The policy can be selected per type by means of the according alias template
+template< typename Derived > using PositiveOrThrow  = Positive<Derived,ThrowOnViolation>;
+template< typename Derived > using PositiveOrAssert = Positive<Derived,AssertOnViolation>;
+template< typename Derived > using AssumePositive   = Positive<Derived,AssumeValid>;
+template< typename Derived > using ClampToPositive  = Positive<Derived,Saturate>;
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   // The new value is checked (and potentially adapted) before it is assigned, i.e. in case of
+   // an exception the strong type remains unchanged
+   template< typename U >
+      requires std::assignable_from<T&,U>
+   constexpr StrongType& operator=( U&& value )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         T tmp( std::forward<U>(value) );
+         this->checkValue(tmp);
+         value_ = std::move(tmp);
+      }
+      else {
+         value_ = std::forward<U>(value);
+      }
+      return *this;
+   }
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+//#include <Positive.h>
+//#include <StrongType.h>
+
+template< typename T, template<typename...> class Check = Positive >
+using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Printable,EqualityComparable,Check>;
+
+
+//---- <Add.h> ------------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <span>
+
+// Element-wise addition: with the 'ThrowOnViolation' policy every addition requires a check
+// and a potential exception, which prevents vectorization of the loop
+template< typename S >
+void add( std::span<S const> a, std::span<S const> b, std::span<S> c )
+{
+   for( std::size_t i=0U; i<c.size(); ++i ) {
+      c[i] = a[i] + b[i];
+   }
+}
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+template< typename S >
+void benchmark( char const* name, std::vector<double> const& values, std::size_t repetitions )
+{
+   std::vector<S> a{}, b{}, c( values.size() );
+   a.reserve( values.size() );
+   b.reserve( values.size() );
+
+   for( double value : values ) {
+      a.emplace_back( value );
+      b.emplace_back( 2.0*value );
+   }
+
+   double const seconds = measure( [&]{
+      for( std::size_t r=0U; r<repetitions; ++r ) {
+         add( std::span<S const>{ a }, std::span<S const>{ b }, std::span<S>{ c } );
+         std::swap( a, c );
+      }
+   } ) / repetitions;
+
+   std::cout << "  " << name << seconds*1E6 << "us (checksum=" << a[values.size()/2U] << ")\n";
+}
+
+int main()
+{
+   // Reaction to violated invariants
+   {
+      try {
+         Meter<double,PositiveOrThrow> m{ 1.0 };
+         m = -2.0;  // Throws and leaves 'm' unchanged
+      }
+      catch( std::invalid_argument const& ex ) {
+         std::cout << "\n ThrowOnViolation: " << ex.what() << '\n';
+      }
+
+      Meter<double,ClampToPositive> m{ -1.0 };
+      std::cout << " Saturate: Meter{ -1.0 } = " << m << '\n';
+
+      m = 3.0;
+      m = m - Meter<double,ClampToPositive>{ 5.0 };
+      std::cout << " Saturate: 3.0 - 5.0 = " << m << '\n';
+   }
+
+   // Runtime of the element-wise addition
+   {
+      constexpr std::size_t N = 10000U;
+      constexpr std::size_t repetitions = 10000U;
+
+      std::mt19937 rng{ std::random_device{}() };
+      std::uniform_real_distribution<double> dist{ 0.0, 1.0 };
+      std::vector<double> values( N );
+      std::generate( begin(values), end(values), [&]{ return dist(rng); } );
+
+      std::cout << "\n Element-wise addition of " << N << " values:\n";
+
+      benchmark<double>                         ( "double:            ", values, repetitions );
+      benchmark<Meter<double,PositiveOrThrow>>  ( "ThrowOnViolation:  ", values, repetitions );
+      benchmark<Meter<double,PositiveOrAssert>> ( "AssertOnViolation: ", values, repetitions );
+      benchmark<Meter<double,AssumePositive>>   ( "AssumeValid:       ", values, repetitions );
+      benchmark<Meter<double,ClampToPositive>>  ( "Saturate:          ", values, repetitions );
+      std::cout << '\n';
+   }
+
+   return EXIT_SUCCESS;
+}
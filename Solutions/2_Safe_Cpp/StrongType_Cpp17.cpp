@@ -42,7 +42,7 @@ struct Addable
    }
 
    friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
-      noexcept( noexcept( lhs.get() + rhs.get() ) )
+      noexcept( noexcept( Derived{ lhs.get() + rhs.get() } ) )
    {
       return Derived{ lhs.get() + rhs.get() };
    }
@@ -62,7 +62,7 @@ struct Subtractable
    }
 
    friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
-      noexcept( noexcept( lhs.get() - rhs.get() ) )
+      noexcept( noexcept( Derived{ lhs.get() - rhs.get() } ) )
    {
       return Derived{ lhs.get() - rhs.get() };
    }
@@ -85,8 +85,7 @@ struct Printable
 {
    friend std::ostream& operator<<( std::ostream& os, Derived const& d )
    {
-      os << d.get();
-      return os;
+      return os << d.get();
    }
 };
 
@@ -31,72 +31,82 @@
 
 //---- <Addable.h> --------------------------------------------------------------------------------
 
-template< typename Derived >
+// The skills are no class templates, but regular classes with hidden friend function templates.
+// Thus every skill is instantiated only once (instead of once per strong type) and its functions
+// are found via ADL for all strong types deriving from the skill (see the explicit object
+// parameters in 'StrongType_Cpp23.cpp').
 struct Addable
 {
-   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+   template< typename S >
+      requires std::is_base_of_v<Addable,S>
+   friend constexpr S& operator+=( S& lhs, S const& rhs )
       noexcept( noexcept( lhs.get() += rhs.get() ) )
    {
       lhs.get() += rhs.get();
       return lhs;
    }
 
-   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
-      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   template< typename S >
+      requires std::is_base_of_v<Addable,S>
+   friend constexpr S operator+( S const& lhs, S const& rhs )
+      noexcept( noexcept( S{ lhs.get() + rhs.get() } ) )
    {
-      return Derived{ lhs.get() + rhs.get() };
+      return S{ lhs.get() + rhs.get() };
    }
 };
 
 
 //---- <Subtractable.h> ---------------------------------------------------------------------------
 
-template< typename Derived >
 struct Subtractable
 {
-   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+   template< typename S >
+      requires std::is_base_of_v<Subtractable,S>
+   friend constexpr S& operator-=( S& lhs, S const& rhs )
       noexcept( noexcept( lhs.get() -= rhs.get() ) )
    {
       lhs.get() -= rhs.get();
       return lhs;
    }
 
-   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
-      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   template< typename S >
+      requires std::is_base_of_v<Subtractable,S>
+   friend constexpr S operator-( S const& lhs, S const& rhs )
+      noexcept( noexcept( S{ lhs.get() - rhs.get() } ) )
    {
-      return Derived{ lhs.get() - rhs.get() };
+      return S{ lhs.get() - rhs.get() };
    }
 };
 
 
 //---- <IntegralArithmetic.h> ---------------------------------------------------------------------
 
-template< typename Derived >
 struct IntegralArithmetic
-   : public Addable<Derived>
-   , public Subtractable<Derived>
+   : public Addable
+   , public Subtractable
 {};
 
 
 //---- <Printable.h> ------------------------------------------------------------------------------
 
-template< typename Derived >
 struct Printable
 {
-   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   template< typename S >
+      requires std::is_base_of_v<Printable,S>
+   friend std::ostream& operator<<( std::ostream& os, S const& s )
    {
-      os << d.get();
-      return os;
+      return os << s.get();
    }
 };
 
 
 //---- <EqualityComparable.h> ---------------------------------------------------------------------
 
-template< typename Derived >
 struct EqualityComparable
 {
-   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   template< typename S >
+      requires std::is_base_of_v<EqualityComparable,S>
+   friend constexpr bool operator==( S const& lhs, S const& rhs )
    {
       return lhs.get() == rhs.get();
    }
@@ -105,7 +115,6 @@ struct EqualityComparable
 
 //---- Positive -----------------------------------------------------------------------------------
 
-template< typename Derived >
 struct Positive
 {
    template< typename T >
@@ -119,9 +128,12 @@ struct Positive
 
 //---- <StrongType.h> -----------------------------------------------------------------------------
 
-template< typename T, typename Tag, template<typename...> class... Skills >
+// Note: The constraints use the type traits instead of the 'std::constructible_from' and
+// 'std::assignable_from' concepts. The concepts (in particular 'std::common_reference_with')
+// are considerably more expensive to check, which is done for every single strong type.
+template< typename T, typename Tag, class... Skills >
 class StrongType final
-   : public Skills< StrongType<T,Tag,Skills...> >...
+   : public Skills...
 {
  public:
    using value_type = T;
@@ -148,7 +160,7 @@ class StrongType final
 
    // Constructor option 2: One constructor with forwarding reference, convertible types allowed
    template< typename U >
-      requires std::constructible_from<T,U>
+      requires std::is_constructible_v<T,U>
    explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
    {
       if constexpr( requires { this->checkValue(value_); } ) {
@@ -166,13 +178,13 @@ class StrongType final
    */
 
    template< typename U >
-      requires std::constructible_from<T,U>
+      requires std::is_constructible_v<T,U>
    constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
       : value_{ value.get() }
    {}
 
    template< typename U >
-      requires std::constructible_from<T,U>
+      requires std::is_constructible_v<T,U>
    constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
       : value_{ std::move(value).get() }
    {}
@@ -191,11 +203,11 @@ class StrongType final
 
    // Assignment operator option 2: One assignment operator with forwarding reference, convertible types allowed
    template< typename U >
-      requires std::assignable_from<T&,U>
+      requires std::is_assignable_v<T&,U>
    constexpr StrongType& operator=( U&& value )
    {
-      if constexpr( requires { this->checkValue(value_); } ) {
-         this->checkValue(value_);
+      if constexpr( requires { this->checkValue(value); } ) {
+         this->checkValue(value);
       }
 
       value_ = std::forward<U>(value);
@@ -208,8 +220,8 @@ class StrongType final
       requires std::same_as<std::remove_cvref_t<U>,T>
    constexpr StrongType& operator=( U&& value )
    {
-      if constexpr( requires { this->checkValue(value_); } ) {
-         this->checkValue(value_);
+      if constexpr( requires { this->checkValue(value); } ) {
+         this->checkValue(value);
       }
 
       value_ = std::forward<U>(value);
@@ -218,7 +230,7 @@ class StrongType final
    */
 
    template< typename U >
-      requires std::assignable_from<T&,U>
+      requires std::is_assignable_v<T&,U>
    constexpr StrongType& operator=( StrongType<U,Tag,Skills...> const& strong )
    {
       value_ = strong.get();
@@ -226,7 +238,7 @@ class StrongType final
    }
 
    template< typename U >
-      requires std::assignable_from<T&,U>
+      requires std::is_assignable_v<T&,U>
    constexpr StrongType& operator=( StrongType<U,Tag,Skills...>&& strong )
    {
       value_ = std::move(strong).get();
@@ -247,7 +259,7 @@ class StrongType final
    T value_{};
 };
 
-template< typename T, typename Tag, template<typename> class... Skills >
+template< typename T, typename Tag, class... Skills >
 constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
    noexcept( std::is_nothrow_swappable_v<T> )
 {
@@ -255,17 +267,89 @@ constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>
 }
 
 
+//---- <IntegerLiteral.h> ------------------------------------------------------------------------
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace detail {
+
+// Parses the digits of an integer literal (decimal, hexadecimal, binary or octal, with optional
+// digit separators) at compile time. Values exceeding 'unsigned long long' are rejected.
+template< char... Chars >
+consteval unsigned long long parse_integer_literal()
+{
+   constexpr char chars[]{ Chars... };
+   constexpr std::size_t size{ sizeof...(Chars) };
+
+   unsigned long long base{ 10U };
+   std::size_t i{ 0U };
+
+   if( size > 1U && chars[0] == '0' ) {
+      if( chars[1] == 'x' || chars[1] == 'X' )      { base = 16U; i = 2U; }
+      else if( chars[1] == 'b' || chars[1] == 'B' ) { base =  2U; i = 2U; }
+      else                                          { base =  8U; i = 1U; }
+   }
+
+   unsigned long long value{ 0U };
+
+   for( ; i<size; ++i )
+   {
+      char const c{ chars[i] };
+      if( c == '\'' ) continue;
+
+      unsigned long long const digit =
+         ( c >= '0' && c <= '9' ) ? static_cast<unsigned long long>( c - '0' ) :
+         ( c >= 'a' && c <= 'f' ) ? static_cast<unsigned long long>( c - 'a' + 10 ) :
+         ( c >= 'A' && c <= 'F' ) ? static_cast<unsigned long long>( c - 'A' + 10 ) : base;
+
+      if( digit >= base ) {
+         throw std::invalid_argument( "Invalid digit in integer literal" );
+      }
+      if( value > ( std::numeric_limits<unsigned long long>::max() - digit ) / base ) {
+         throw std::out_of_range( "Integer literal out of range" );
+      }
+
+      value = value*base + digit;
+   }
+
+   return value;
+}
+
+// The narrowest type that can represent the given value exactly (same as for integer literals
+// without suffix)
+template< unsigned long long Value >
+using narrowest_integer_t =
+   std::conditional_t< Value <= static_cast<unsigned long long>( std::numeric_limits<int>::max() ), int,
+   std::conditional_t< Value <= static_cast<unsigned long long>( std::numeric_limits<long>::max() ), long,
+                       long long > >;
+
+template< unsigned long long Value >
+constexpr bool fits_integer_v =
+   Value <= static_cast<unsigned long long>( std::numeric_limits<long long>::max() );
+
+} // namespace detail
+
+
 //---- <Meter.h> ----------------------------------------------------------------------------------
 
 template< typename T >
 using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Printable,EqualityComparable,Positive>;
 
-[[nodiscard]] constexpr Meter<long> operator""_m( unsigned long long m ) noexcept
+// The digits are parsed at compile time: the literal results in the narrowest type that can
+// represent the value exactly and literals exceeding 'long long' do not compile
+template< char... Chars >
+[[nodiscard]] consteval auto operator""_m()
 {
-   return Meter<long>{ static_cast<long>(m) };
+   constexpr unsigned long long m{ detail::parse_integer_literal<Chars...>() };
+   static_assert( detail::fits_integer_v<m>, "Meter literal out of range" );
+
+   using T = detail::narrowest_integer_t<m>;
+   return Meter<T>{ static_cast<T>(m) };
 }
 
-[[nodiscard]] constexpr Meter<long double> operator""_m( long double m ) noexcept
+[[nodiscard]] consteval Meter<long double> operator""_m( long double m ) noexcept
 {
    return Meter<long double>{ m };
 }
@@ -276,14 +360,19 @@ using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Printable,Equality
 template< typename T >
 using Kilometer = StrongType<T,struct KilometerTag,IntegralArithmetic,Printable,EqualityComparable>;
 
-[[nodiscard]] constexpr Kilometer<int> operator""_km( unsigned long long m ) noexcept
+template< char... Chars >
+[[nodiscard]] consteval auto operator""_km()
 {
-   return Kilometer<int>{ static_cast<int>(m) };
+   constexpr unsigned long long km{ detail::parse_integer_literal<Chars...>() };
+   static_assert( detail::fits_integer_v<km>, "Kilometer literal out of range" );
+
+   using T = detail::narrowest_integer_t<km>;
+   return Kilometer<T>{ static_cast<T>(km) };
 }
 
-[[nodiscard]] constexpr Kilometer<long double> operator""_km( long double m ) noexcept
+[[nodiscard]] consteval Kilometer<long double> operator""_km( long double km ) noexcept
 {
-   return Kilometer<long double>{ m };
+   return Kilometer<long double>{ km };
 }
 
 
@@ -320,5 +409,15 @@ int main()
    static_assert( Meter<long>{100L} + Meter<long>{50L} == Meter<long>{150L} );
    static_assert( Kilometer<int>{100} - Kilometer<int>{50} != Kilometer<int>{150} );
 
+   // Literals
+   static_assert( std::same_as< decltype(100_m), Meter<int> > );
+   static_assert( std::same_as< decltype(3'000'000'000_m), Meter<long> > );
+   static_assert( std::same_as< decltype(0x7F_km), Kilometer<int> > );
+   static_assert( std::same_as< decltype(1.5_km), Kilometer<long double> > );
+   static_assert( 1'000_m == Meter<int>{ 1000 } );
+   static_assert( 0b1010_m + 012_m == Meter<int>{ 20 } );
+   //constexpr auto m = 5_m - 10_m;             // Does not compile (negative value)
+   //auto const m = 9'223'372'036'854'775'808_m;  // Does not compile (literal out of range)
+
    return EXIT_SUCCESS;
 }
@@ -43,7 +43,7 @@ struct Addable
 
    template< typename T >
    constexpr T operator+( this T const& lhs, T const& rhs )
-      noexcept( noexcept( lhs.get() + rhs.get() ) )
+      noexcept( noexcept( T{ lhs.get() + rhs.get() } ) )
    {
       return T{ lhs.get() + rhs.get() };
    }
@@ -64,7 +64,7 @@ struct Subtractable
 
    template< typename T >
    constexpr T operator-( this T const& lhs, T const& rhs )
-      noexcept( noexcept( lhs.get() - rhs.get() ) )
+      noexcept( noexcept( T{ lhs.get() - rhs.get() } ) )
    {
       return T{ lhs.get() - rhs.get() };
    }
@@ -118,6 +118,9 @@ struct Positive
 
 //---- <StrongType.h> -----------------------------------------------------------------------------
 
+// Note: The constraints use the type traits instead of the 'std::constructible_from' and
+// 'std::assignable_from' concepts. The concepts (in particular 'std::common_reference_with')
+// are considerably more expensive to check, which is done for every single strong type.
 template< typename T, typename Tag, class... Skills >
 class StrongType final
    : public Skills...
@@ -147,7 +150,7 @@ class StrongType final
 
    // Constructor option 2: One constructor with forwarding reference, convertible types allowed
    template< typename U >
-      requires std::constructible_from<T,U>
+      requires std::is_constructible_v<T,U>
    explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
    {
       if constexpr( requires { this->checkValue(value_); } ) {
@@ -165,13 +168,13 @@ class StrongType final
    */
 
    template< typename U >
-      requires std::constructible_from<T,U>
+      requires std::is_constructible_v<T,U>
    constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
       : value_{ value.get() }
    {}
 
    template< typename U >
-      requires std::constructible_from<T,U>
+      requires std::is_constructible_v<T,U>
    constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
       : value_{ std::move(value).get() }
    {}
@@ -190,11 +193,11 @@ class StrongType final
 
    // Assignment operator option 2: One assignment operator with forwarding reference, convertible types allowed
    template< typename U >
-      requires std::assignable_from<T&,U>
+      requires std::is_assignable_v<T&,U>
    constexpr StrongType& operator=( U&& value )
    {
-      if constexpr( requires { this->checkValue(value_); } ) {
-         this->checkValue(value_);
+      if constexpr( requires { this->checkValue(value); } ) {
+         this->checkValue(value);
       }
 
       value_ = std::forward<U>(value);
@@ -207,8 +210,8 @@ class StrongType final
       requires std::same_as<std::remove_cvref_t<U>,T>
    constexpr StrongType& operator=( U&& value )
    {
-      if constexpr( requires { this->checkValue(value_); } ) {
-         this->checkValue(value_);
+      if constexpr( requires { this->checkValue(value); } ) {
+         this->checkValue(value);
       }
 
       value_ = std::forward<U>(value);
@@ -217,7 +220,7 @@ class StrongType final
    */
 
    template< typename U >
-      requires std::assignable_from<T&,U>
+      requires std::is_assignable_v<T&,U>
    constexpr StrongType& operator=( StrongType<U,Tag,Skills...> const& strong )
    {
       value_ = strong.get();
@@ -225,7 +228,7 @@ class StrongType final
    }
 
    template< typename U >
-      requires std::assignable_from<T&,U>
+      requires std::is_assignable_v<T&,U>
    constexpr StrongType& operator=( StrongType<U,Tag,Skills...>&& strong )
    {
       value_ = std::move(strong).get();
@@ -260,17 +263,89 @@ constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>
 }
 
 
+//---- <IntegerLiteral.h> ------------------------------------------------------------------------
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace detail {
+
+// Parses the digits of an integer literal (decimal, hexadecimal, binary or octal, with optional
+// digit separators) at compile time. Values exceeding 'unsigned long long' are rejected.
+template< char... Chars >
+consteval unsigned long long parse_integer_literal()
+{
+   constexpr char chars[]{ Chars... };
+   constexpr std::size_t size{ sizeof...(Chars) };
+
+   unsigned long long base{ 10U };
+   std::size_t i{ 0U };
+
+   if( size > 1U && chars[0] == '0' ) {
+      if( chars[1] == 'x' || chars[1] == 'X' )      { base = 16U; i = 2U; }
+      else if( chars[1] == 'b' || chars[1] == 'B' ) { base =  2U; i = 2U; }
+      else                                          { base =  8U; i = 1U; }
+   }
+
+   unsigned long long value{ 0U };
+
+   for( ; i<size; ++i )
+   {
+      char const c{ chars[i] };
+      if( c == '\'' ) continue;
+
+      unsigned long long const digit =
+         ( c >= '0' && c <= '9' ) ? static_cast<unsigned long long>( c - '0' ) :
+         ( c >= 'a' && c <= 'f' ) ? static_cast<unsigned long long>( c - 'a' + 10 ) :
+         ( c >= 'A' && c <= 'F' ) ? static_cast<unsigned long long>( c - 'A' + 10 ) : base;
+
+      if( digit >= base ) {
+         throw std::invalid_argument( "Invalid digit in integer literal" );
+      }
+      if( value > ( std::numeric_limits<unsigned long long>::max() - digit ) / base ) {
+         throw std::out_of_range( "Integer literal out of range" );
+      }
+
+      value = value*base + digit;
+   }
+
+   return value;
+}
+
+// The narrowest type that can represent the given value exactly (same as for integer literals
+// without suffix)
+template< unsigned long long Value >
+using narrowest_integer_t =
+   std::conditional_t< Value <= static_cast<unsigned long long>( std::numeric_limits<int>::max() ), int,
+   std::conditional_t< Value <= static_cast<unsigned long long>( std::numeric_limits<long>::max() ), long,
+                       long long > >;
+
+template< unsigned long long Value >
+constexpr bool fits_integer_v =
+   Value <= static_cast<unsigned long long>( std::numeric_limits<long long>::max() );
+
+} // namespace detail
+
+
 //---- <Meter.h> ----------------------------------------------------------------------------------
 
 template< typename T >
 using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Printable,EqualityComparable,Positive>;
 
-[[nodiscard]] constexpr Meter<long> operator""_m( unsigned long long m ) noexcept
+// The digits are parsed at compile time: the literal results in the narrowest type that can
+// represent the value exactly and literals exceeding 'long long' do not compile
+template< char... Chars >
+[[nodiscard]] consteval auto operator""_m()
 {
-   return Meter<long>{ static_cast<long>(m) };
+   constexpr unsigned long long m{ detail::parse_integer_literal<Chars...>() };
+   static_assert( detail::fits_integer_v<m>, "Meter literal out of range" );
+
+   using T = detail::narrowest_integer_t<m>;
+   return Meter<T>{ static_cast<T>(m) };
 }
 
-[[nodiscard]] constexpr Meter<long double> operator""_m( long double m ) noexcept
+[[nodiscard]] consteval Meter<long double> operator""_m( long double m ) noexcept
 {
    return Meter<long double>{ m };
 }
@@ -281,14 +356,19 @@ using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Printable,Equality
 template< typename T >
 using Kilometer = StrongType<T,struct KilometerTag,IntegralArithmetic,Printable,EqualityComparable>;
 
-[[nodiscard]] constexpr Kilometer<int> operator""_km( unsigned long long m ) noexcept
+template< char... Chars >
+[[nodiscard]] consteval auto operator""_km()
 {
-   return Kilometer<int>{ static_cast<int>(m) };
+   constexpr unsigned long long km{ detail::parse_integer_literal<Chars...>() };
+   static_assert( detail::fits_integer_v<km>, "Kilometer literal out of range" );
+
+   using T = detail::narrowest_integer_t<km>;
+   return Kilometer<T>{ static_cast<T>(km) };
 }
 
-[[nodiscard]] constexpr Kilometer<long double> operator""_km( long double m ) noexcept
+[[nodiscard]] consteval Kilometer<long double> operator""_km( long double km ) noexcept
 {
-   return Kilometer<long double>{ m };
+   return Kilometer<long double>{ km };
 }
 
 
@@ -325,5 +405,15 @@ int main()
    static_assert( Meter<long>{100L} + Meter<long>{50L} == Meter<long>{150L} );
    static_assert( Kilometer<int>{100} - Kilometer<int>{50} != Kilometer<int>{150} );
 
+   // Literals
+   static_assert( std::same_as< decltype(100_m), Meter<int> > );
+   static_assert( std::same_as< decltype(3'000'000'000_m), Meter<long> > );
+   static_assert( std::same_as< decltype(0x7F_km), Kilometer<int> > );
+   static_assert( std::same_as< decltype(1.5_km), Kilometer<long double> > );
+   static_assert( 1'000_m == Meter<int>{ 1000 } );
+   static_assert( 0b1010_m + 012_m == Meter<int>{ 20 } );
+   //constexpr auto m = 5_m - 10_m;             // Does not compile (negative value)
+   //auto const m = 9'223'372'036'854'775'808_m;  // Does not compile (literal out of range)
+
    return EXIT_SUCCESS;
 }
@@ -0,0 +1,535 @@
+/**************************************************************************************************
+*
+* \file StrongType_Dimensions.cpp
+* \brief C++ Training - Programming example about dimensional analysis with strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Replace the bare 'double' data members of the 'Animal' class (size in cm, weight in kg,
+*       speed in km/h) by strong types. The tag of the strong types encodes the exponents of the
+*       base dimensions (length, mass, time) and the scale factor relative to the SI base unit.
+*       Multiplying or dividing two quantities results in a quantity of the according dimension,
+*       and all scale factors are combined at compile time, i.e. the strong types compile to the
+*       same instructions as raw 'double' arithmetic (see 'Codegen/StrongType_Dimensions.cpp').
+*
+* Step 1: Compare the assembly output of the two 'time_for()' functions (for instance by means
+*         of Compiler Explorer; godbolt.org). Is there any overhead for the strong types?
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      os << d.get();
+      return os;
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <Dimension.h> ------------------------------------------------------------------------------
+
+// Exponents of the base dimensions length, mass and time
+template< int L, int M, int T >
+struct Dimension
+{};
+
+template< typename D1, typename D2 >
+struct DimensionProduct;
+
+template< int L1, int M1, int T1, int L2, int M2, int T2 >
+struct DimensionProduct< Dimension<L1,M1,T1>, Dimension<L2,M2,T2> >
+{
+   using type = Dimension<L1+L2,M1+M2,T1+T2>;
+};
+
+template< typename D1, typename D2 >
+struct DimensionQuotient;
+
+template< int L1, int M1, int T1, int L2, int M2, int T2 >
+struct DimensionQuotient< Dimension<L1,M1,T1>, Dimension<L2,M2,T2> >
+{
+   using type = Dimension<L1-L2,M1-M2,T1-T2>;
+};
+
+using Dimensionless = Dimension<0,0,0>;
+using LengthDimension = Dimension<1,0,0>;
+using MassDimension = Dimension<0,1,0>;
+using TimeDimension = Dimension<0,0,1>;
+using VelocityDimension = Dimension<1,0,-1>;
+
+
+//---- <Unit.h> -----------------------------------------------------------------------------------
+
+//#include <Dimension.h>
+//#include <StrongType.h>
+#include <numeric>
+#include <ratio>
+
+// Tag for strong types representing a physical quantity: all units of the same dimension share
+// the 'Dimension' and differ only in the scale factor relative to the SI base unit.
+template< typename Dimension, typename Ratio >
+struct UnitTag
+{};
+
+template< typename S >
+struct QuantityTraits
+{};
+
+template< typename T, typename Dimension, typename Ratio, template<typename...> class... Skills >
+struct QuantityTraits< StrongType<T,UnitTag<Dimension,Ratio>,Skills...> >
+{
+   using value_type = T;
+   using dimension = Dimension;
+   using ratio = typename Ratio::type;
+
+   template< typename U, typename D, typename R >
+   using rebind = StrongType<U,UnitTag<D,typename R::type>,Skills...>;
+};
+
+template< typename S >
+concept Quantity = requires { typename QuantityTraits<S>::dimension; };
+
+template< typename S1, typename S2 >
+concept SameDimension =
+   Quantity<S1> && Quantity<S2> &&
+   std::same_as< typename QuantityTraits<S1>::dimension, typename QuantityTraits<S2>::dimension >;
+
+// The common unit of two units is the largest unit that both units are an integral multiple of
+// (analogous to 'std::chrono::duration'), e.g. 'Meter' for 'Meter' and 'Kilometer'.
+template< typename R1, typename R2 >
+using CommonRatio = std::ratio< std::gcd( R1::num, R2::num ), std::lcm( R1::den, R2::den ) >;
+
+template< typename S1, typename S2 >
+   requires SameDimension<S1,S2>
+using CommonQuantity = typename QuantityTraits<S1>::template rebind<
+   std::common_type_t< typename S1::value_type, typename S2::value_type >,
+   typename QuantityTraits<S1>::dimension,
+   CommonRatio< typename QuantityTraits<S1>::ratio, typename QuantityTraits<S2>::ratio > >;
+
+
+//---- <QuantityCast.h> ---------------------------------------------------------------------------
+
+//#include <Unit.h>
+#include <cstdint>
+
+// Multiplies the given value by the compile time factor 'Factor' (a single multiplication, or
+// division for an integral downscaling, or no operation at all)
+template< typename T, typename Factor, typename U >
+constexpr T scale( U const& value )
+{
+   using C = std::common_type_t< T, U, std::intmax_t >;
+
+   if constexpr( Factor::num == 1 && Factor::den == 1 ) {
+      return static_cast<T>( value );
+   }
+   else if constexpr( Factor::den == 1 ) {
+      return static_cast<T>( static_cast<C>( value ) * static_cast<C>( Factor::num ) );
+   }
+   else if constexpr( std::floating_point<C> ) {
+      constexpr C factor{ static_cast<C>( Factor::num ) / static_cast<C>( Factor::den ) };
+      return static_cast<T>( static_cast<C>( value ) * factor );
+   }
+   else if constexpr( Factor::num == 1 ) {
+      return static_cast<T>( static_cast<C>( value ) / static_cast<C>( Factor::den ) );
+   }
+   else {
+      return static_cast<T>( static_cast<C>( value ) * static_cast<C>( Factor::num )
+                                                     / static_cast<C>( Factor::den ) );
+   }
+}
+
+// Conversion between two units of the same dimension
+template< Quantity To, Quantity From >
+   requires SameDimension<To,From>
+constexpr To quantity_cast( From const& from )
+{
+   using Factor = std::ratio_divide< typename QuantityTraits<From>::ratio
+                                   , typename QuantityTraits<To>::ratio >;
+   return To{ scale<typename To::value_type,Factor>( from.get() ) };
+}
+
+
+//---- <UnitArithmetic.h> -------------------------------------------------------------------------
+
+//#include <QuantityCast.h>
+#include <compare>
+
+// Arithmetic and comparison operations between different units of the same dimension. The
+// result is expressed in the common unit of both operands.
+template< typename Derived >
+struct UnitArithmetic
+{
+   template< typename Other >
+      requires ( SameDimension<Derived,Other> && !std::same_as<Derived,Other> )
+   friend constexpr auto operator+( Derived const& lhs, Other const& rhs )
+   {
+      using R = CommonQuantity<Derived,Other>;
+      return R{ quantity_cast<R>( lhs ).get() + quantity_cast<R>( rhs ).get() };
+   }
+
+   template< typename Other >
+      requires ( SameDimension<Derived,Other> && !std::same_as<Derived,Other> )
+   friend constexpr auto operator-( Derived const& lhs, Other const& rhs )
+   {
+      using R = CommonQuantity<Derived,Other>;
+      return R{ quantity_cast<R>( lhs ).get() - quantity_cast<R>( rhs ).get() };
+   }
+
+   template< typename Other >
+      requires ( SameDimension<Derived,Other> && !std::same_as<Derived,Other> )
+   friend constexpr bool operator==( Derived const& lhs, Other const& rhs )
+   {
+      using R = CommonQuantity<Derived,Other>;
+      return quantity_cast<R>( lhs ).get() == quantity_cast<R>( rhs ).get();
+   }
+
+   template< typename Other >
+      requires ( SameDimension<Derived,Other> && !std::same_as<Derived,Other> )
+   friend constexpr auto operator<=>( Derived const& lhs, Other const& rhs )
+   {
+      using R = CommonQuantity<Derived,Other>;
+      return quantity_cast<R>( lhs ).get() <=> quantity_cast<R>( rhs ).get();
+   }
+};
+
+
+//---- <DimensionalArithmetic.h> ------------------------------------------------------------------
+
+//#include <QuantityCast.h>
+
+// Multiplication and division of quantities of arbitrary dimensions. The dimension exponents are
+// added (subtracted) and the scale factors are multiplied (divided) at compile time, i.e. the
+// operations result in exactly the same instructions as the according operations on raw values.
+// Dimensionless results are returned as raw values in the SI base unit.
+template< typename R, typename T >
+constexpr auto makeQuantity( T const& value )
+{
+   using Q = QuantityTraits<R>;
+
+   if constexpr( std::same_as< typename Q::dimension, Dimensionless > ) {
+      return scale<T,typename Q::ratio>( value );
+   }
+   else {
+      return R{ value };
+   }
+}
+
+template< typename Derived >
+struct DimensionalArithmetic
+{
+   template< Quantity Other, typename D = Derived >
+   friend constexpr auto operator*( Derived const& lhs, Other const& rhs )
+   {
+      using L = QuantityTraits<D>;
+      using R = QuantityTraits<Other>;
+      using T = std::common_type_t< typename L::value_type, typename R::value_type >;
+      using Result = typename L::template rebind<
+         T,
+         typename DimensionProduct< typename L::dimension, typename R::dimension >::type,
+         std::ratio_multiply< typename L::ratio, typename R::ratio > >;
+
+      return makeQuantity<Result>( static_cast<T>( lhs.get() * rhs.get() ) );
+   }
+
+   template< Quantity Other, typename D = Derived >
+   friend constexpr auto operator/( Derived const& lhs, Other const& rhs )
+   {
+      using L = QuantityTraits<D>;
+      using R = QuantityTraits<Other>;
+      using T = std::common_type_t< typename L::value_type, typename R::value_type >;
+      using Result = typename L::template rebind<
+         T,
+         typename DimensionQuotient< typename L::dimension, typename R::dimension >::type,
+         std::ratio_divide< typename L::ratio, typename R::ratio > >;
+
+      return makeQuantity<Result>( static_cast<T>( lhs.get() / rhs.get() ) );
+   }
+
+   // Scaling by a raw value
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived operator*( Derived const& lhs, U const& factor )
+   {
+      return Derived{ lhs.get() * factor };
+   }
+
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived operator*( U const& factor, Derived const& rhs )
+   {
+      return Derived{ factor * rhs.get() };
+   }
+
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived operator/( Derived const& lhs, U const& divisor )
+   {
+      return Derived{ lhs.get() / divisor };
+   }
+};
+
+
+//---- <Units.h> ----------------------------------------------------------------------------------
+
+//#include <DimensionalArithmetic.h>
+//#include <UnitArithmetic.h>
+
+template< typename T, typename Dimension, typename Ratio >
+using Unit = StrongType<T,UnitTag<Dimension,typename Ratio::type>
+                       ,IntegralArithmetic,Printable,EqualityComparable,UnitArithmetic,DimensionalArithmetic>;
+
+template< typename T > using Meter      = Unit<T,LengthDimension,std::ratio<1>>;
+template< typename T > using Centimeter = Unit<T,LengthDimension,std::centi>;
+template< typename T > using Kilometer  = Unit<T,LengthDimension,std::kilo>;
+
+template< typename T > using Kilogram   = Unit<T,MassDimension,std::ratio<1>>;
+
+template< typename T > using Second     = Unit<T,TimeDimension,std::ratio<1>>;
+template< typename T > using Hour       = Unit<T,TimeDimension,std::ratio<3600>>;
+
+template< typename T > using MeterPerSecond   = Unit<T,VelocityDimension,std::ratio<1>>;
+template< typename T > using KilometerPerHour = Unit<T,VelocityDimension,std::ratio_divide<std::kilo,std::ratio<3600>>>;
+
+[[nodiscard]] constexpr Meter<double> operator""_m( long double m ) noexcept
+{
+   return Meter<double>{ static_cast<double>( m ) };
+}
+
+[[nodiscard]] constexpr Centimeter<double> operator""_cm( long double cm ) noexcept
+{
+   return Centimeter<double>{ static_cast<double>( cm ) };
+}
+
+[[nodiscard]] constexpr Kilometer<double> operator""_km( long double km ) noexcept
+{
+   return Kilometer<double>{ static_cast<double>( km ) };
+}
+
+[[nodiscard]] constexpr Kilogram<double> operator""_kg( long double kg ) noexcept
+{
+   return Kilogram<double>{ static_cast<double>( kg ) };
+}
+
+[[nodiscard]] constexpr Hour<double> operator""_h( long double h ) noexcept
+{
+   return Hour<double>{ static_cast<double>( h ) };
+}
+
+[[nodiscard]] constexpr KilometerPerHour<double> operator""_kmh( long double kmh ) noexcept
+{
+   return KilometerPerHour<double>{ static_cast<double>( kmh ) };
+}
+
+
+//---- <Animal.h> ---------------------------------------------------------------------------------
+
+//#include <Units.h>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+struct Animal
+{
+   std::string name;
+   Centimeter<double> size{};
+   Kilogram<double> weight{};
+   KilometerPerHour<double> speed{};
+
+   friend std::ostream& operator<<( std::ostream& os, Animal const& animal )
+   {
+      os << std::setw(24) << std::left << animal.name
+         << ": size=" << std::setw(5) << std::right << animal.size
+         << ", weight=" << std::setw(7)  << std::right << animal.weight
+         << ", speed=" << std::setw(4)  << std::right << animal.speed;
+      return os;
+   }
+};
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <vector>
+
+template< typename S1, typename S2 >
+concept SupportsAddition = requires( S1 s1, S2 s2 ) { s1 + s2; };
+
+// Time in seconds to cover the given distance in meters at the given speed in km/h
+double time_for( double distance, double speed )
+{
+   return distance / speed * 3.6;
+}
+
+Second<double> time_for( Meter<double> distance, KilometerPerHour<double> speed )
+{
+   return quantity_cast<Second<double>>( distance / speed );
+}
+
+int main()
+{
+   // Dimensions and scale factors of the results are computed at compile time
+   static_assert( std::same_as< decltype( 2.0_km / 0.5_h ), KilometerPerHour<double> > );
+   static_assert( quantity_cast<MeterPerSecond<double>>( 36.0_kmh ) == MeterPerSecond<double>{ 10.0 } );
+   static_assert( 100.0_cm == 1.0_m );
+   static_assert( 2.0_m / 50.0_cm == 4.0 );  // Dimensionless
+   static_assert( std::same_as< decltype( 2.0_m * 3.0_m ), Unit<double,Dimension<2,0,0>,std::ratio<1>> > );
+
+   // Different dimensions cannot be mixed
+   static_assert( !SameDimension< Meter<double>, Second<double> > );
+   static_assert( !SupportsAddition< Meter<double>, Second<double> > );
+
+   std::vector<Animal> const animals
+      { Animal{ "Lion", 250.0_cm, 270.0_kg, 80.0_kmh }
+      , Animal{ "King Cobra", 550.0_cm, 20.0_kg, 18.0_kmh }
+      , Animal{ "Giant Kangaroo", 140.0_cm, 55.0_kg, 80.0_kmh }
+      , Animal{ "Polar Bear", 280.0_cm, 1000.0_kg, 40.0_kmh }
+      , Animal{ "African Elephant", 750.0_cm, 6000.0_kg, 40.0_kmh } };
+
+   std::cout << '\n';
+   for( auto const& animal : animals )
+   {
+      auto const sprint = time_for( 100.0_m, animal.speed );
+      double const body_lengths = animal.speed * Second<double>{ 1.0 } / animal.size;  // Dimensionless
+
+      std::cout << animal << "  ->  100m in " << sprint << "s, "
+                << body_lengths << " body lengths per second\n";
+   }
+   std::cout << '\n';
+
+   return EXIT_SUCCESS;
+}
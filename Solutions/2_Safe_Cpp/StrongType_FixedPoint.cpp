@@ -0,0 +1,759 @@
+/**************************************************************************************************
+*
+* \file StrongType_FixedPoint.cpp
+* \brief C++ Training - Programming example about a fixed-point representation for strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: The results of floating point computations depend on the order of operations (and thus
+*       on the compiler, the optimization level and the number of threads). Provide a fixed-point
+*       type 'FixedPoint<FractionalBits>' (a 64-bit integer with the given number of fractional
+*       bits), which can be used as underlying type of 'StrongType' and which provides bitwise
+*       reproducible results. Additionally provide the user-defined literal '_m', which parses
+*       the given literal (e.g. '1.25_m') exactly at compile time.
+*
+* Step 1: Compare the runtime of the span kernels for 'Meter<double>' and 'Meter<Fixed>'.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Scalable.h> -------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Scalable
+{
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived& operator*=( Derived& lhs, U const& factor )
+      noexcept( noexcept( lhs.get() *= factor ) )
+   {
+      lhs.get() *= factor;
+      return lhs;
+   }
+
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived operator*( Derived const& lhs, U const& factor )
+      noexcept( noexcept( lhs.get() * factor ) )
+   {
+      return Derived{ lhs.get() * factor };
+   }
+
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived operator*( U const& factor, Derived const& rhs )
+      noexcept( noexcept( factor * rhs.get() ) )
+   {
+      return Derived{ factor * rhs.get() };
+   }
+};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      os << d.get();
+      return os;
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <Comparable.h> -----------------------------------------------------------------------------
+
+template< typename Derived >
+struct Comparable
+   : public EqualityComparable<Derived>
+{
+   friend constexpr auto operator<=>( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() <=> rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <HasSkill.h> -------------------------------------------------------------------------------
+
+// Checks whether the strong type 'S' provides the given skill (directly or via a compound skill)
+template< typename S, template<typename...> class Skill >
+concept HasSkill = std::derived_from< S, Skill<S> >;
+
+
+//---- <SpanKernels.h> ----------------------------------------------------------------------------
+
+//#include <HasSkill.h>
+//#include <StrongType.h>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+// All kernels operate directly on the underlying values (via 'get()') instead of creating
+// temporary strong types. Thus the loops are identical to the according loops on raw values
+// and can be vectorized in the same way.
+
+template< typename S >
+   requires HasSkill<S,Addable>
+constexpr void add( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result )
+{
+   assert( lhs.size() == rhs.size() && lhs.size() == result.size() );
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      result[i].get() = lhs[i].get() + rhs[i].get();
+   }
+}
+
+template< typename S >
+   requires HasSkill<S,Subtractable>
+constexpr void subtract( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result )
+{
+   assert( lhs.size() == rhs.size() && lhs.size() == result.size() );
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      result[i].get() = lhs[i].get() - rhs[i].get();
+   }
+}
+
+// values[i] *= factor
+template< typename S >
+   requires HasSkill<S,Scalable>
+constexpr void scale( std::span<S> values, typename S::value_type const& factor )
+{
+   for( auto& value : values ) {
+      value.get() *= factor;
+   }
+}
+
+// y[i] += a * x[i]
+template< typename S >
+   requires ( HasSkill<S,Addable> && HasSkill<S,Scalable> )
+constexpr void axpy( typename S::value_type const& a, std::span<S const> x, std::span<S> y )
+{
+   assert( x.size() == y.size() );
+
+   for( std::size_t i=0U; i<y.size(); ++i ) {
+      y[i].get() += a * x[i].get();
+   }
+}
+
+// Sum of all values. The four independent partial sums break the dependency chain of the
+// additions, which allows vectorization even for floating point values (without '-ffast-math').
+template< typename S >
+   requires HasSkill<S,Addable>
+constexpr S sum( std::span<S const> values )
+{
+   using T = typename S::value_type;
+
+   T partial[4]{};
+   std::size_t const n4{ values.size() - values.size()%4U };
+   std::size_t i{ 0U };
+
+   for( ; i<n4; i+=4U ) {
+      partial[0] += values[i   ].get();
+      partial[1] += values[i+1U].get();
+      partial[2] += values[i+2U].get();
+      partial[3] += values[i+3U].get();
+   }
+   for( ; i<values.size(); ++i ) {
+      partial[0] += values[i].get();
+   }
+
+   return S{ ( partial[0] + partial[1] ) + ( partial[2] + partial[3] ) };
+}
+
+template< typename S >
+   requires HasSkill<S,Comparable>
+constexpr S min( std::span<S const> values )
+{
+   assert( !values.empty() );
+
+   auto result = values[0].get();
+   for( auto const& value : values.subspan(1U) ) {
+      result = value.get() < result ? value.get() : result;
+   }
+
+   return S{ result };
+}
+
+template< typename S >
+   requires HasSkill<S,Comparable>
+constexpr S max( std::span<S const> values )
+{
+   assert( !values.empty() );
+
+   auto result = values[0].get();
+   for( auto const& value : values.subspan(1U) ) {
+      result = value.get() > result ? value.get() : result;
+   }
+
+   return S{ result };
+}
+
+
+//---- <FixedPoint.h> -----------------------------------------------------------------------------
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+namespace detail {
+
+// Converts the decimal fraction 'digits / pow10' (with 'digits < pow10 <= 10^18') into a binary
+// fraction with the given number of bits (rounded to nearest, ties away from zero). The result
+// is exact, since it is computed via long division instead of via a floating point value.
+constexpr std::uint64_t decimal_to_binary_fraction( std::uint64_t digits, std::uint64_t pow10, int bits ) noexcept
+{
+   std::uint64_t result{ 0U };
+
+   for( int i=0; i<bits; ++i ) {
+      digits *= 2U;
+      result *= 2U;
+      if( digits >= pow10 ) {
+         digits -= pow10;
+         ++result;
+      }
+   }
+
+   if( 2U*digits >= pow10 ) {
+      ++result;
+   }
+
+   return result;
+}
+
+struct DecimalFraction
+{
+   std::uint64_t digits{};
+   int count{};
+};
+
+// Computes the shortest decimal fraction that is converted back into the given binary fraction
+// (with 'fraction < 2^bits' and 'bits <= 59', i.e. at most 18 decimal digits are required).
+constexpr DecimalFraction shortest_decimal_fraction( std::uint64_t fraction, int bits ) noexcept
+{
+   std::uint64_t const mask{ ( std::uint64_t{1} << bits ) - 1U };
+   std::uint64_t rest{ fraction };
+   std::uint64_t digits{ 0U };
+   std::uint64_t pow10{ 1U };
+
+   for( int count=1; count<18; ++count )
+   {
+      rest *= 10U;
+      digits = digits*10U + ( rest >> bits );
+      rest &= mask;
+      pow10 *= 10U;
+
+      if( decimal_to_binary_fraction( digits, pow10, bits ) == fraction ) {
+         return { digits, count };
+      }
+      if( rest != 0U && decimal_to_binary_fraction( digits+1U, pow10, bits ) == fraction ) {
+         return { digits+1U, count };
+      }
+   }
+
+   rest *= 10U;
+   digits = digits*10U + ( rest >> bits );
+   return { digits, 18 };
+}
+
+// Computes 'a * b / 2^shift', truncated towards zero
+constexpr std::int64_t multiply( std::int64_t a, std::int64_t b, int shift ) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+   __int128 const product{ static_cast<__int128>( a ) * b };
+   return static_cast<std::int64_t>( product / ( static_cast<__int128>( 1 ) << shift ) );
+#else
+   bool const negative{ ( a < 0 ) != ( b < 0 ) };
+   std::uint64_t const x{ a < 0 ? 0U - static_cast<std::uint64_t>( a ) : static_cast<std::uint64_t>( a ) };
+   std::uint64_t const y{ b < 0 ? 0U - static_cast<std::uint64_t>( b ) : static_cast<std::uint64_t>( b ) };
+
+   // 64x64 -> 128 bit multiplication via 32-bit halves
+   std::uint64_t const lo_lo{ ( x & 0xFFFFFFFFU ) * ( y & 0xFFFFFFFFU ) };
+   std::uint64_t const hi_lo{ ( x >> 32U ) * ( y & 0xFFFFFFFFU ) };
+   std::uint64_t const lo_hi{ ( x & 0xFFFFFFFFU ) * ( y >> 32U ) };
+   std::uint64_t const hi_hi{ ( x >> 32U ) * ( y >> 32U ) };
+   std::uint64_t const cross{ ( lo_lo >> 32U ) + ( hi_lo & 0xFFFFFFFFU ) + lo_hi };
+   std::uint64_t const hi{ hi_hi + ( hi_lo >> 32U ) + ( cross >> 32U ) };
+   std::uint64_t const lo{ ( cross << 32U ) | ( lo_lo & 0xFFFFFFFFU ) };
+
+   std::uint64_t const magnitude{ shift == 0 ? lo : ( hi << (64-shift) ) | ( lo >> shift ) };
+   return negative ? static_cast<std::int64_t>( 0U - magnitude ) : static_cast<std::int64_t>( magnitude );
+#endif
+}
+
+// Computes 'a * 2^shift / b', truncated towards zero
+constexpr std::int64_t divide( std::int64_t a, std::int64_t b, int shift ) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+   return static_cast<std::int64_t>( ( static_cast<__int128>( a ) << shift ) / b );
+#else
+   bool const negative{ ( a < 0 ) != ( b < 0 ) };
+   std::uint64_t const x{ a < 0 ? 0U - static_cast<std::uint64_t>( a ) : static_cast<std::uint64_t>( a ) };
+   std::uint64_t const y{ b < 0 ? 0U - static_cast<std::uint64_t>( b ) : static_cast<std::uint64_t>( b ) };
+
+   // Binary long division of the 128-bit value 'x * 2^shift' by 'y'
+   std::uint64_t const hi{ shift == 0 ? 0U : x >> (64-shift) };
+   std::uint64_t const lo{ x << shift };
+   std::uint64_t quotient{ 0U };
+   std::uint64_t remainder{ 0U };
+
+   for( int i=127; i>=0; --i ) {
+      std::uint64_t const bit{ ( ( i >= 64 ? hi >> (i-64) : lo >> i ) & 1U ) };
+      bool const carry{ ( remainder >> 63U ) != 0U };
+      remainder = ( remainder << 1U ) | bit;
+      quotient <<= 1U;
+      if( carry || remainder >= y ) {
+         remainder -= y;
+         quotient |= 1U;
+      }
+   }
+
+   return negative ? static_cast<std::int64_t>( 0U - quotient ) : static_cast<std::int64_t>( quotient );
+#endif
+}
+
+} // namespace detail
+
+
+// Signed fixed-point number with 64 bits, of which 'FractionalBits' are used for the fractional
+// part. Addition, subtraction and comparison are integer operations and thus bitwise reproducible
+// and associative. Multiplication and division of two fixed-point numbers truncate towards zero
+// and require a 128-bit intermediate result; multiplication and division by integers are plain
+// 64-bit integer operations, which can be vectorized.
+template< int FractionalBits >
+   requires ( FractionalBits >= 0 && FractionalBits <= 59 )
+class FixedPoint
+{
+ public:
+   using rep = std::int64_t;
+
+   static constexpr int fractional_bits = FractionalBits;
+   static constexpr rep one = rep{1} << FractionalBits;
+
+   constexpr FixedPoint() = default;
+
+   template< std::integral I >
+   constexpr explicit FixedPoint( I value ) noexcept
+      : raw_( static_cast<rep>( value ) * one )
+   {}
+
+   // Rounds the given floating point value to the nearest fixed-point number
+   template< std::floating_point F >
+   constexpr explicit FixedPoint( F value ) noexcept
+      : raw_( static_cast<rep>( value < F{} ? value*one - F{0.5} : value*one + F{0.5} ) )
+   {}
+
+   [[nodiscard]] static constexpr FixedPoint from_raw( rep raw ) noexcept
+   {
+      FixedPoint result{};
+      result.raw_ = raw;
+      return result;
+   }
+
+   [[nodiscard]] constexpr rep raw() const noexcept { return raw_; }
+
+   template< std::floating_point F >
+   constexpr explicit operator F() const noexcept
+   {
+      return static_cast<F>( raw_ ) / static_cast<F>( one );
+   }
+
+   constexpr FixedPoint& operator+=( FixedPoint rhs ) noexcept { raw_ += rhs.raw_; return *this; }
+   constexpr FixedPoint& operator-=( FixedPoint rhs ) noexcept { raw_ -= rhs.raw_; return *this; }
+
+   constexpr FixedPoint& operator*=( FixedPoint rhs ) noexcept
+   {
+      raw_ = detail::multiply( raw_, rhs.raw_, FractionalBits );
+      return *this;
+   }
+
+   constexpr FixedPoint& operator/=( FixedPoint rhs ) noexcept
+   {
+      raw_ = detail::divide( raw_, rhs.raw_, FractionalBits );
+      return *this;
+   }
+
+   // The integer is converted to 'rep' first, since a 64-bit unsigned operand (e.g. 'std::size_t')
+   // would convert a negative value to unsigned
+   template< std::integral I >
+   constexpr FixedPoint& operator*=( I factor ) noexcept { raw_ *= static_cast<rep>( factor ); return *this; }
+
+   template< std::integral I >
+   constexpr FixedPoint& operator/=( I divisor ) noexcept { raw_ /= static_cast<rep>( divisor ); return *this; }
+
+   friend constexpr FixedPoint operator-( FixedPoint value ) noexcept { return from_raw( -value.raw_ ); }
+
+   friend constexpr FixedPoint operator+( FixedPoint lhs, FixedPoint rhs ) noexcept { return lhs += rhs; }
+   friend constexpr FixedPoint operator-( FixedPoint lhs, FixedPoint rhs ) noexcept { return lhs -= rhs; }
+   friend constexpr FixedPoint operator*( FixedPoint lhs, FixedPoint rhs ) noexcept { return lhs *= rhs; }
+   friend constexpr FixedPoint operator/( FixedPoint lhs, FixedPoint rhs ) noexcept { return lhs /= rhs; }
+
+   template< std::integral I >
+   friend constexpr FixedPoint operator*( FixedPoint lhs, I factor ) noexcept { return lhs *= factor; }
+
+   template< std::integral I >
+   friend constexpr FixedPoint operator*( I factor, FixedPoint rhs ) noexcept { return rhs *= factor; }
+
+   template< std::integral I >
+   friend constexpr FixedPoint operator/( FixedPoint lhs, I divisor ) noexcept { return lhs /= divisor; }
+
+   constexpr std::strong_ordering operator<=>( FixedPoint const& ) const = default;
+
+   // Prints the shortest decimal representation that is converted back into the same value
+   friend std::ostream& operator<<( std::ostream& os, FixedPoint value )
+   {
+      std::uint64_t const magnitude{ value.raw_ < 0 ? 0U - static_cast<std::uint64_t>( value.raw_ )
+                                                    : static_cast<std::uint64_t>( value.raw_ ) };
+      std::uint64_t const fraction{ magnitude & static_cast<std::uint64_t>( one-1 ) };
+
+      char buffer[48];
+      char* ptr{ buffer + sizeof(buffer) };
+
+      if( fraction != 0U ) {
+         auto [digits, count] = detail::shortest_decimal_fraction( fraction, FractionalBits );
+         for( ; count>0; --count, digits/=10U ) {
+            *--ptr = static_cast<char>( '0' + digits%10U );
+         }
+         *--ptr = '.';
+      }
+
+      std::uint64_t integer{ magnitude >> FractionalBits };
+      do {
+         *--ptr = static_cast<char>( '0' + integer%10U );
+         integer /= 10U;
+      } while( integer != 0U );
+
+      if( value.raw_ < 0 ) {
+         *--ptr = '-';
+      }
+
+      return os << std::string_view( ptr, static_cast<std::size_t>( buffer + sizeof(buffer) - ptr ) );
+   }
+
+ private:
+   rep raw_{};
+};
+
+
+namespace detail {
+
+// Parses a decimal floating point literal (e.g. '1.25' or '1'000.5') exactly into a fixed-point
+// number. Literals with exponent, hexadecimal literals, literals with more than 18 fractional
+// digits and literals exceeding the range of the fixed-point number are rejected.
+template< typename Fixed, char... Chars >
+consteval Fixed parse_fixed_point()
+{
+   constexpr int bits{ Fixed::fractional_bits };
+   constexpr char chars[]{ Chars... };
+
+   std::uint64_t integer{ 0U };
+   std::uint64_t digits{ 0U };
+   std::uint64_t pow10{ 1U };
+   bool fraction{ false };
+
+   for( char const c : chars )
+   {
+      if( c == '\'' ) continue;
+
+      if( c == '.' && !fraction ) {
+         fraction = true;
+      }
+      else if( c < '0' || c > '9' ) {
+         throw std::invalid_argument( "Unsupported fixed-point literal (only decimal digits are supported)" );
+      }
+      else if( fraction ) {
+         if( pow10 == 1'000'000'000'000'000'000U ) {
+            throw std::invalid_argument( "Too many fractional digits in fixed-point literal" );
+         }
+         digits = digits*10U + static_cast<std::uint64_t>( c - '0' );
+         pow10 *= 10U;
+      }
+      else {
+         if( integer > ( std::numeric_limits<std::uint64_t>::max() - 9U ) / 10U ) {
+            throw std::out_of_range( "Fixed-point literal out of range" );
+         }
+         integer = integer*10U + static_cast<std::uint64_t>( c - '0' );
+      }
+   }
+
+   constexpr std::uint64_t max{ static_cast<std::uint64_t>( std::numeric_limits<std::int64_t>::max() ) };
+   std::uint64_t const binary_fraction{ decimal_to_binary_fraction( digits, pow10, bits ) };
+
+   if( integer > ( max >> bits ) || ( integer << bits ) > max - binary_fraction ) {
+      throw std::out_of_range( "Fixed-point literal out of range" );
+   }
+
+   return Fixed::from_raw( static_cast<std::int64_t>( ( integer << bits ) + binary_fraction ) );
+}
+
+} // namespace detail
+
+
+// Fixed-point type for distances: range of +/-2^31 (more than two million kilometers for
+// meters) with a resolution of 2^-32 (less than a nanometer for meters)
+using Fixed = FixedPoint<32>;
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+//#include <FixedPoint.h>
+
+template< typename T >
+using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Scalable,Comparable,Printable>;
+
+template< char... Chars >
+consteval Meter<Fixed> operator""_m()
+{
+   return Meter<Fixed>{ detail::parse_fixed_point<Fixed,Chars...>() };
+}
+
+static_assert( sizeof(Meter<Fixed>) == sizeof(std::int64_t) );
+static_assert( ( 1.25_m ).get().raw() == Fixed::one + Fixed::one/4 );
+static_assert( 0.1_m + 0.2_m == 0.3_m );
+static_assert( 1'000.5_m == Meter<Fixed>{ Fixed{ 1000.5 } } );
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+// Runtime of the span kernels for strong types of type 'S'
+template< typename S >
+double benchmark( std::vector<double> const& raw_x, std::vector<double> const& raw_y,
+                  typename S::value_type a, S& result )
+{
+   constexpr std::size_t repetitions = 10U;
+
+   std::vector<S> x( raw_x.size() ), y( raw_y.size() ), z( raw_x.size() );
+   std::ranges::transform( raw_x, begin(x), []( double d ){ return S{ typename S::value_type{d} }; } );
+   std::ranges::transform( raw_y, begin(y), []( double d ){ return S{ typename S::value_type{d} }; } );
+
+   return measure( [&]{
+      for( std::size_t r=0U; r<repetitions; ++r ) {
+         std::span<S const> const cx{ x }, cy{ y }, cz{ z };
+         add( cx, cy, std::span{ z } );
+         axpy( a, cx, std::span{ z } );
+         result += sum( cz ) + max( cz );
+      }
+   } ) / repetitions;
+}
+
+int main()
+{
+   // Exact literals and printing
+   {
+      auto const distance = 1.25_m + 0.1_m;
+
+      std::cout << "\n 1.25_m + 0.1_m = " << distance << "m"
+                << "\n 1.25_m * 3 / 4 = " << Meter<Fixed>{ distance.get() * 3 / 4 } << "m"
+                << "\n 1.5_m * 2.5   = " << 1.5_m * Fixed{ 2.5 } << "m\n";
+
+      // Negative values and unsigned integers (mixed signedness)
+      Fixed const half{ Fixed{ -1.0 } / std::size_t{ 2U } };
+      Fixed const twice{ Fixed{ -1.5 } * std::size_t{ 2U } };
+      std::cout << " -1.0 / 2U      = " << half
+                << "\n -1.5 * 2U      = " << twice << "\n";
+      if( half != Fixed{ -0.5 } || twice != Fixed{ -3.0 } ) {
+         std::cerr << "\n ERROR: Wrong result of a mixed-sign operation\n";
+         return EXIT_FAILURE;
+      }
+   }
+
+   // Reproducibility: the result of a summation does not depend on the order of the values
+   {
+      constexpr std::size_t N = 1000000U;
+
+      std::mt19937 mt{ 42U };
+      std::uniform_real_distribution<double> dist{ 0.0, 100.0 };
+
+      std::vector<double> values( N );
+      std::ranges::generate( values, [&]{ return dist(mt); } );
+
+      std::vector<Meter<Fixed>> fixed( N );
+      std::ranges::transform( values, begin(fixed), []( double d ){ return Meter<Fixed>{ Fixed{d} }; } );
+
+      double const forward{ std::accumulate( values.begin(), values.end(), 0.0 ) };
+      double const backward{ std::accumulate( values.rbegin(), values.rend(), 0.0 ) };
+      auto const fixed_forward{ std::accumulate( fixed.begin(), fixed.end(), Meter<Fixed>{} ) };
+      auto const fixed_backward{ std::accumulate( fixed.rbegin(), fixed.rend(), Meter<Fixed>{} ) };
+
+      std::cout << std::boolalpha
+                << "\n Order independent summation of " << N << " values:"
+                << "\n  double: " << ( forward == backward )
+                << "\n  Fixed:  " << ( fixed_forward == fixed_backward ) << "\n";
+   }
+
+   // Runtime of the span kernels
+   {
+      constexpr std::size_t N = 10000000U;
+
+      std::random_device rd{};
+      std::mt19937 mt{ rd() };
+      std::uniform_real_distribution<double> dist{ 0.0, 1.0 };
+
+      std::vector<double> raw_x( N ), raw_y( N );
+      std::ranges::generate( raw_x, [&]{ return dist(mt); } );
+      std::ranges::generate( raw_y, [&]{ return dist(mt); } );
+
+      Meter<double> double_result{};
+      Meter<Fixed> fixed_result{};
+
+      double const seconds_double = benchmark( raw_x, raw_y, 0.5, double_result );
+      double const seconds_fixed = benchmark( raw_x, raw_y, Fixed{ 0.5 }, fixed_result );
+
+      std::cout << "\n Runtime of add+axpy+sum+max on " << N << " values:"
+                << "\n  Meter<double> : " << seconds_double * 1E3 << "ms (result=" << double_result << ")"
+                << "\n  Meter<Fixed>  : " << seconds_fixed * 1E3 << "ms (result=" << fixed_result << ")\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,497 @@
+/**************************************************************************************************
+*
+* \file StrongType_Format.cpp
+* \brief C++ Training - Programming example about fast formatting of strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: The 'Printable' skill writes strong types via 'std::ostream', which is slow for logs of
+*       millions of values. Provide a 'Formattable' skill, which
+*        - provides a 'write_to()' member function that writes the value and the unit suffix
+*          of the strong type (given by the tag) via 'std::to_chars()' into a character buffer
+*        - enables 'std::format()' for the strong type (if '<format>' is available)
+*       Based on this skill, provide a bulk formatting function for spans of strong types.
+*
+* Step 1: Compare the runtime of the bulk formatting and formatting via 'std::ostream'.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      return os << d.get();
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <HasSkill.h> -------------------------------------------------------------------------------
+
+// Checks whether the strong type 'S' provides the given skill (directly or via a compound skill)
+template< typename S, template<typename...> class Skill >
+concept HasSkill = std::derived_from< S, Skill<S> >;
+
+
+//---- <UnitSuffix.h> -----------------------------------------------------------------------------
+
+//#include <StrongType.h>
+#include <string_view>
+
+// The unit suffix of a strong type is given by a static 'suffix' data member of its tag. Tags
+// without suffix result in an empty suffix.
+template< typename S >
+struct UnitSuffix
+{
+   static constexpr std::string_view value{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+   requires requires { { Tag::suffix } -> std::convertible_to<std::string_view>; }
+struct UnitSuffix< StrongType<T,Tag,Skills...> >
+{
+   static constexpr std::string_view value{ Tag::suffix };
+};
+
+template< typename S >
+constexpr std::string_view unit_suffix_v = UnitSuffix<S>::value;
+
+
+//---- <Formattable.h> ----------------------------------------------------------------------------
+
+//#include <UnitSuffix.h>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <system_error>
+
+namespace detail {
+
+// Writes the given value like 'std::to_chars( first, last, value, std::chars_format::general,
+// precision )', i.e. like 'std::ostream' with the given precision. The common case (fixed
+// notation with up to 9 significant digits) is rounded via the scaled integer value instead of
+// the exact (and expensive) decimal expansion. Values close to a rounding boundary, values in
+// scientific notation and larger precisions are written by 'std::to_chars()'.
+inline std::to_chars_result to_chars_general( char* first, char* last, double value, int precision )
+{
+   constexpr int maxPrecision{ 9 };
+   constexpr std::array<double,13> powers{ 1E0, 1E1, 1E2, 1E3, 1E4, 1E5, 1E6, 1E7, 1E8, 1E9, 1E10, 1E11, 1E12 };
+   constexpr std::array<double,13> thresholds{ 1E-4, 1E-3, 1E-2, 1E-1, 1E0, 1E1, 1E2, 1E3, 1E4, 1E5, 1E6, 1E7, 1E8 };
+
+   int const p{ std::max( precision, 1 ) };
+   double const magnitude{ std::abs( value ) };
+
+   if( p > maxPrecision || !( magnitude >= thresholds.front() && magnitude < 1E9 ) || last - first < 32 ) {
+      return std::to_chars( first, last, value, std::chars_format::general, precision );
+   }
+
+   // Decimal exponent 'e' of the value and the value scaled to 'p' digits before the decimal point
+   int e{ static_cast<int>( std::ranges::upper_bound( thresholds, magnitude ) - thresholds.begin() ) - 5 };
+   auto const scale = [magnitude,&powers]( int k ){ return ( k >= 0 ) ? magnitude*powers[k] : magnitude/powers[-k]; };
+   double scaled{ scale( p-1-e ) };
+   if( scaled < powers[p-1] ) {
+      scaled = scale( p-e );
+      --e;
+   }
+
+   double const integral{ std::floor( scaled ) };
+   if( std::abs( scaled - integral - 0.5 ) < 1E-6 ) {
+      return std::to_chars( first, last, value, std::chars_format::general, precision );
+   }
+
+   auto digits{ static_cast<std::uint64_t>( integral ) + ( scaled - integral > 0.5 ? 1U : 0U ) };
+   if( digits == static_cast<std::uint64_t>( powers[p] ) ) {
+      digits /= 10U;
+      ++e;
+   }
+   if( e < -4 || e >= p ) {
+      return std::to_chars( first, last, value, std::chars_format::general, precision );
+   }
+
+   char buffer[maxPrecision];
+   char* end{ std::to_chars( buffer, buffer+maxPrecision, digits ).ptr };
+
+   if( value < 0.0 ) {
+      *first++ = '-';
+   }
+   if( e >= 0 ) {
+      first = std::copy( buffer, buffer+e+1, first );
+   }
+   else {
+      *first++ = '0';
+   }
+
+   // Fractional digits without trailing zeros
+   char* const fraction{ ( e >= 0 ) ? buffer+e+1 : buffer };
+   while( end > fraction && end[-1] == '0' ) {
+      --end;
+   }
+   if( end > fraction ) {
+      *first++ = '.';
+      first = std::fill_n( first, std::max( -e-1, 0 ), '0' );
+      first = std::copy( fraction, end, first );
+   }
+
+   return { first, std::errc{} };
+}
+
+} // namespace detail
+
+template< typename Derived >
+struct Formattable
+{
+   // Writes the value (in its shortest round-trip representation) and the unit suffix into the
+   // range [first,last). In case the range is too small, 'std::errc::value_too_large' is returned
+   // and the content of the range is unspecified.
+   std::to_chars_result write_to( char* first, char* last ) const
+   {
+      auto const& self = static_cast<Derived const&>( *this );
+      return append_suffix( std::to_chars( first, last, self.get() ), last );
+   }
+
+   // Writes the floating point value with the given precision (in the same representation as
+   // 'std::ostream' with the given precision) and the unit suffix into the range [first,last).
+   std::to_chars_result write_to( char* first, char* last, int precision ) const
+      requires std::floating_point<typename Derived::value_type>
+   {
+      auto const& self = static_cast<Derived const&>( *this );
+      if constexpr( std::same_as<typename Derived::value_type,double> ) {
+         return append_suffix( detail::to_chars_general( first, last, self.get(), precision ), last );
+      }
+      else {
+         return append_suffix(
+            std::to_chars( first, last, self.get(), std::chars_format::general, precision ), last );
+      }
+   }
+
+ private:
+   static std::to_chars_result append_suffix( std::to_chars_result result, char* last )
+   {
+      constexpr std::string_view suffix{ unit_suffix_v<Derived> };
+
+      if( result.ec == std::errc{} ) {
+         if( static_cast<std::size_t>( last - result.ptr ) < suffix.size() ) {
+            return { last, std::errc::value_too_large };
+         }
+         result.ptr = std::ranges::copy( suffix, result.ptr ).out;
+      }
+
+      return result;
+   }
+};
+
+
+#if defined(__cpp_lib_format)
+
+#include <format>
+
+// Formats the underlying value according to the given format specification (e.g. "{:.2f}") and
+// appends the unit suffix
+template< typename T, typename Tag, template<typename...> class... Skills >
+   requires HasSkill< StrongType<T,Tag,Skills...>, Formattable >
+struct std::formatter< StrongType<T,Tag,Skills...>, char >
+   : public std::formatter<T,char>
+{
+   template< typename FormatContext >
+   auto format( StrongType<T,Tag,Skills...> const& value, FormatContext& context ) const
+   {
+      auto out = std::formatter<T,char>::format( value.get(), context );
+      return std::ranges::copy( unit_suffix_v< StrongType<T,Tag,Skills...> >, out ).out;
+   }
+};
+
+#endif
+
+
+//---- <BulkFormat.h> -----------------------------------------------------------------------------
+
+//#include <Formattable.h>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace detail {
+
+template< typename S, typename Writer >
+void format_to( std::string& out, std::span<S const> values, char separator, Writer writer )
+{
+   // The shortest round-trip representation of a 'double' requires at most 24 characters
+   constexpr std::size_t maxLength{ 32U + unit_suffix_v<S>.size() + 1U };
+
+   std::size_t const offset{ out.size() };
+   out.resize( offset + values.size()*maxLength );
+
+   char* ptr{ out.data() + offset };
+   char* const last{ out.data() + out.size() };
+
+   for( S const& value : values )
+   {
+      auto const result = writer( value, ptr, last );
+      if( result.ec != std::errc{} ) {
+         out.resize( offset );
+         throw std::system_error( std::make_error_code( result.ec ) );
+      }
+      ptr = result.ptr;
+      *ptr++ = separator;
+   }
+
+   out.resize( static_cast<std::size_t>( ptr - out.data() ) );
+}
+
+} // namespace detail
+
+
+// Appends all given values (each followed by the given separator) to the given string. The
+// string is enlarged once for the worst case, all values are written directly into the string
+// and finally the string is shrunk to the actual size.
+template< typename S >
+   requires HasSkill<S,Formattable>
+void format_to( std::string& out, std::span<S const> values, char separator = '\n' )
+{
+   detail::format_to( out, values, separator, []( S const& value, char* first, char* last ){
+      return value.write_to( first, last );
+   } );
+}
+
+template< typename S >
+   requires HasSkill<S,Formattable> && std::floating_point<typename S::value_type>
+void format_to( std::string& out, std::span<S const> values, int precision, char separator = '\n' )
+{
+   if( precision < 0 || precision > 17 ) {
+      throw std::invalid_argument( "Invalid precision detected" );
+   }
+
+   detail::format_to( out, values, separator, [precision]( S const& value, char* first, char* last ){
+      return value.write_to( first, last, precision );
+   } );
+}
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+//#include <Formattable.h>
+//#include <IntegralArithmetic.h>
+//#include <Printable.h>
+
+struct MeterTag
+{
+   static constexpr std::string_view suffix{ "m" };
+};
+
+template< typename T >
+using Meter = StrongType<T,MeterTag,IntegralArithmetic,Printable,EqualityComparable,Formattable>;
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <vector>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+int main()
+{
+   // Formatting of single values
+   {
+      Meter<double> const m{ 12.5 };
+
+      char buffer[32];
+      auto const result = m.write_to( buffer, buffer+sizeof(buffer) );
+      std::cout << "\n write_to():    " << std::string_view( buffer, result.ptr ) << '\n';
+
+#if defined(__cpp_lib_format)
+      std::cout << " std::format(): " << std::format( "{:.3f}", m ) << '\n';
+#endif
+   }
+
+   // Bulk formatting
+   {
+      constexpr std::size_t N = 1000000U;
+
+      std::mt19937 rng{ std::random_device{}() };
+      std::uniform_real_distribution<double> dist{ 0.0, 1000.0 };
+
+      std::vector<Meter<double>> meters{};
+      meters.reserve( N );
+      for( std::size_t i=0U; i<N; ++i ) {
+         meters.emplace_back( dist(rng) );
+      }
+
+      std::string log_ostream{};
+      std::string log_bulk{};
+
+      double const seconds_ostream = measure( [&]{
+         std::ostringstream oss{};
+         for( auto const& m : meters ) {
+            oss << m << MeterTag::suffix << '\n';
+         }
+         log_ostream = std::move(oss).str();
+      } );
+
+      // Same representation as 'std::ostream' (i.e. precision 6)
+      double const seconds_bulk = measure( [&]{
+         format_to( log_bulk, std::span<Meter<double> const>{ meters }, 6 );
+      } );
+
+      // Shortest round-trip representation
+      std::string log_exact{};
+      double const seconds_exact = measure( [&]{
+         format_to( log_exact, std::span<Meter<double> const>{ meters } );
+      } );
+
+      std::cout << "\n Formatting of " << N << " values:"
+                << "\n  std::ostream:  " << seconds_ostream*1E3 << "ms (" << log_ostream.size() << " characters)"
+                << "\n  format_to():   " << seconds_bulk*1E3 << "ms (" << log_bulk.size() << " characters)"
+                << "\n  Speedup:       " << seconds_ostream/seconds_bulk
+                << "\n  Same output:   " << std::boolalpha << ( log_ostream == log_bulk )
+                << "\n  format_to() (round-trip): " << seconds_exact*1E3 << "ms (" << log_exact.size() << " characters)\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,347 @@
+/**************************************************************************************************
+*
+* \file StrongType_Index.cpp
+* \brief C++ Training - Programming example about strongly typed indices and spans
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Avoid index mix-ups between different collections (e.g. the columns of different
+*       structure-of-arrays tables). An 'Index<Tag>' can only be used to access a
+*       'StrongSpan<T,Tag>' with the same tag. Access via 'at()' is always bounds checked. The
+*       indices produced by 'indices()' are in range by construction, so within such a loop the
+*       compiler removes the check and 'at()' compiles to the same loads as 'operator[]' on raw
+*       values (see 'Codegen/StrongType_Index.cpp').
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      os << d.get();
+      return os;
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <Comparable.h> -----------------------------------------------------------------------------
+
+template< typename Derived >
+struct Comparable
+   : public EqualityComparable<Derived>
+{
+   friend constexpr auto operator<=>( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() <=> rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <Index.h> ----------------------------------------------------------------------------------
+
+//#include <StrongType.h>
+#include <cstddef>
+
+// An index into a collection identified by 'Tag'. Indices can be compared and printed, but there
+// is no implicit conversion from or to 'std::size_t'.
+template< typename Tag >
+using Index = StrongType<std::size_t,Tag,Comparable,Printable>;
+
+
+//---- <IndexRange.h> -----------------------------------------------------------------------------
+
+//#include <Index.h>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+
+// The range of all indices [0,size) of a collection identified by 'Tag'. The end of the range is
+// represented by a sentinel, which compares as 'index >= size' (instead of 'index != size'). Thus
+// every index within the loop is known to be smaller than the size, which is the information
+// the optimizer needs to remove subsequent bounds checks.
+template< typename Tag >
+class IndexRange
+   : public std::ranges::view_interface< IndexRange<Tag> >
+{
+ public:
+   class Sentinel
+   {
+    public:
+      constexpr Sentinel() = default;
+      explicit constexpr Sentinel( std::size_t size ) noexcept : size_( size ) {}
+
+      [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+
+    private:
+      std::size_t size_{};
+   };
+
+   class Iterator
+   {
+    public:
+      using value_type      = Index<Tag>;
+      using difference_type = std::ptrdiff_t;
+
+      constexpr Iterator() = default;
+      explicit constexpr Iterator( std::size_t index ) noexcept : index_( index ) {}
+
+      [[nodiscard]] constexpr Index<Tag> operator*() const noexcept { return Index<Tag>{ index_ }; }
+
+      constexpr Iterator& operator++() noexcept { ++index_; return *this; }
+      constexpr Iterator operator++( int ) noexcept { auto const tmp{ *this }; ++index_; return tmp; }
+
+      friend constexpr bool operator==( Iterator const&, Iterator const& ) = default;
+
+      friend constexpr bool operator==( Iterator const& it, Sentinel const& end ) noexcept
+      {
+         return it.index_ >= end.size();
+      }
+
+    private:
+      std::size_t index_{};
+   };
+
+   constexpr IndexRange() = default;
+   explicit constexpr IndexRange( std::size_t size ) noexcept : size_( size ) {}
+
+   [[nodiscard]] constexpr Iterator begin() const noexcept { return Iterator{ 0U }; }
+   [[nodiscard]] constexpr Sentinel end() const noexcept { return Sentinel{ size_ }; }
+
+ private:
+   std::size_t size_{};
+};
+
+
+//---- <StrongSpan.h> -----------------------------------------------------------------------------
+
+//#include <Index.h>
+//#include <IndexRange.h>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+// A view on a contiguous sequence of 'T', which can only be indexed by an 'Index<Tag>'. In
+// contrast to 'std::span', the size is a runtime value only (i.e. there is no static extent).
+template< typename T, typename Tag >
+class StrongSpan
+{
+ public:
+   using element_type = T;
+   using value_type   = std::remove_cv_t<T>;
+   using index_type   = Index<Tag>;
+   using iterator     = typename std::span<T>::iterator;
+
+   constexpr StrongSpan() = default;
+
+   explicit constexpr StrongSpan( std::span<T> values ) noexcept
+      : values_( values )
+   {}
+
+   [[nodiscard]] constexpr std::size_t size() const noexcept { return values_.size(); }
+   [[nodiscard]] constexpr bool empty() const noexcept { return values_.empty(); }
+
+   // Unchecked access (checked by an assertion in debug mode)
+   [[nodiscard]] constexpr T& operator[]( Index<Tag> index ) const noexcept
+   {
+      assert( index.get() < values_.size() );
+      return values_[index.get()];
+   }
+
+   // Checked access
+   [[nodiscard]] constexpr T& at( Index<Tag> index ) const
+   {
+      if( index.get() >= values_.size() ) [[unlikely]] {
+         throw std::out_of_range( "Invalid index detected" );
+      }
+      return values_[index.get()];
+   }
+
+   [[nodiscard]] constexpr iterator begin() const noexcept { return values_.begin(); }
+   [[nodiscard]] constexpr iterator end() const noexcept { return values_.end(); }
+
+   [[nodiscard]] constexpr std::span<T> underlying() const noexcept { return values_; }
+
+ private:
+   std::span<T> values_{};
+};
+
+// All valid indices of the given span. Since the span is taken by value, the size used for the
+// loop and the size used for the bounds check in 'at()' are provably the same, which enables
+// the compiler to remove the check.
+template< typename T, typename Tag >
+[[nodiscard]] constexpr IndexRange<Tag> indices( StrongSpan<T,Tag> span ) noexcept
+{
+   return IndexRange<Tag>{ span.size() };
+}
+
+
+//---- <Particles.h> ------------------------------------------------------------------------------
+
+//#include <StrongSpan.h>
+#include <vector>
+
+// Structure-of-arrays tables: all columns of a table share the tag of the table
+struct Particles
+{
+   std::vector<double> positions;
+   std::vector<double> masses;
+};
+
+struct Sensors
+{
+   std::vector<double> readings;
+};
+
+using ParticleSpan = StrongSpan<double const,Particles>;
+using SensorSpan   = StrongSpan<double const,Sensors>;
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+template< typename Span, typename I >
+concept IndexableBy = requires( Span span, I index ){ span.at( index ); };
+
+// The center of mass of all particles. The index of the masses is used to access the positions
+// of the same table, thus the check of 'positions.at()' remains (but there can be no mix-up with
+// other tables).
+double centerOfMass( ParticleSpan positions, ParticleSpan masses )
+{
+   double weighted{};
+   double total{};
+
+   for( auto const i : indices( masses ) ) {
+      weighted += positions.at(i) * masses.at(i);
+      total += masses.at(i);
+   }
+
+   return weighted / total;
+}
+
+int main()
+{
+   // An index can only be used for a span with the same tag ...
+   static_assert(  IndexableBy< ParticleSpan, Index<Particles> > );
+   static_assert( !IndexableBy< ParticleSpan, Index<Sensors> > );
+   // ... and raw integral values cannot be used as indices at all
+   static_assert( !IndexableBy< ParticleSpan, std::size_t > );
+   static_assert( !IndexableBy< ParticleSpan, int > );
+
+   // Indices are as cheap as raw indices
+   static_assert( sizeof(Index<Particles>) == sizeof(std::size_t) );
+   static_assert( std::is_trivially_copyable_v<Index<Particles>> );
+   static_assert( std::ranges::forward_range<IndexRange<Particles>> );
+
+   Particles const particles{ { 1.0, 2.0, 4.0 }, { 2.0, 1.0, 1.0 } };
+   Sensors const sensors{ { 0.5, 1.5 } };
+
+   ParticleSpan const positions{ particles.positions };
+   ParticleSpan const masses{ particles.masses };
+   SensorSpan const readings{ sensors.readings };
+
+   std::cout << "\n center of mass = " << centerOfMass( positions, masses ) << "\n";
+
+   double sum{};
+   for( auto const i : indices( readings ) ) {
+      sum += readings.at(i);  // No check in the generated code
+   }
+   std::cout << " sum of readings = " << sum << "\n";
+
+   //readings.at( Index<Particles>{ 2U } );  // Does not compile (index of a different table)
+   //readings.at( 2U );                      // Does not compile (raw index)
+
+   try {
+      static_cast<void>( readings.at( Index<Sensors>{ 2U } ) );
+   }
+   catch( std::out_of_range const& ex ) {
+      std::cout << " index 2: " << ex.what() << "\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
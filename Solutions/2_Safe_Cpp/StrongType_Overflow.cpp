@@ -0,0 +1,634 @@
+/**************************************************************************************************
+*
+* \file StrongType_Overflow.cpp
+* \brief C++ Training - Programming example about overflow-aware arithmetic for strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: The 'Addable' and 'Subtractable' skills silently overflow (which for signed integral
+*       types is even undefined behavior). Provide three alternative skills for integral types:
+*        - 'CheckedArithmetic': throws a 'std::overflow_error' exception in case of an overflow
+*        - 'SaturatingArithmetic': clamps the result to the range of the underlying type
+*        - 'WrappingArithmetic': well-defined two's complement wrap-around
+*       For spans of strong types, provide batch variants of addition and subtraction that do
+*       not branch per element, but accumulate the overflow information of all elements in a
+*       single flag, which is only checked once at the end.
+*
+* Step 1: Compare the runtime of the element-wise checked addition, the checked batch addition
+*         and the unchecked addition of raw values (for instance with '-O3 -march=native').
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Overflow.h> -------------------------------------------------------------------------------
+
+#include <limits>
+
+namespace detail {
+
+// Computes 'result = a + b' with two's complement wrap-around and returns whether the addition
+// overflowed
+template< std::integral T >
+constexpr bool add_overflow( T a, T b, T& result ) noexcept
+{
+#if defined(__GNUC__)
+   return __builtin_add_overflow( a, b, &result );
+#else
+   using U = std::make_unsigned_t<T>;
+   result = static_cast<T>( static_cast<U>(a) + static_cast<U>(b) );
+   if constexpr( std::is_signed_v<T> ) {
+      return ( ( a ^ result ) & ( b ^ result ) ) < 0;
+   }
+   else {
+      return result < a;
+   }
+#endif
+}
+
+// Computes 'result = a - b' with two's complement wrap-around and returns whether the
+// subtraction overflowed
+template< std::integral T >
+constexpr bool sub_overflow( T a, T b, T& result ) noexcept
+{
+#if defined(__GNUC__)
+   return __builtin_sub_overflow( a, b, &result );
+#else
+   using U = std::make_unsigned_t<T>;
+   result = static_cast<T>( static_cast<U>(a) - static_cast<U>(b) );
+   if constexpr( std::is_signed_v<T> ) {
+      return ( ( a ^ b ) & ( a ^ result ) ) < 0;
+   }
+   else {
+      return a < b;
+   }
+#endif
+}
+
+// The closest representable value in case 'a + b' or 'a - b' overflowed: for signed types the
+// direction of the overflow is given by the sign of 'a', unsigned additions can only overflow
+// upwards and unsigned subtractions only downwards
+template< std::integral T >
+constexpr T saturated_add( T a ) noexcept
+{
+   if constexpr( std::is_signed_v<T> ) {
+      return ( a < T{} ) ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+   }
+   else {
+      return std::numeric_limits<T>::max();
+   }
+}
+
+template< std::integral T >
+constexpr T saturated_sub( T a ) noexcept
+{
+   if constexpr( std::is_signed_v<T> ) {
+      return ( a < T{} ) ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+   }
+   else {
+      return std::numeric_limits<T>::min();
+   }
+}
+
+} // namespace detail
+
+
+//---- <CheckedArithmetic.h> ----------------------------------------------------------------------
+
+//#include <Overflow.h>
+#include <stdexcept>
+
+template< std::integral T >
+constexpr T checked_add( T a, T b )
+{
+   T result{};
+   if( detail::add_overflow( a, b, result ) ) [[unlikely]] {
+      throw std::overflow_error( "Integer overflow detected" );
+   }
+   return result;
+}
+
+template< std::integral T >
+constexpr T checked_sub( T a, T b )
+{
+   T result{};
+   if( detail::sub_overflow( a, b, result ) ) [[unlikely]] {
+      throw std::overflow_error( "Integer overflow detected" );
+   }
+   return result;
+}
+
+// Addition and subtraction, which throw a 'std::overflow_error' exception in case of an overflow.
+// In case of an exception, the left-hand side operand of the compound assignment is unchanged.
+template< typename Derived >
+struct CheckedArithmetic
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+   {
+      lhs.get() = checked_add( lhs.get(), rhs.get() );
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+   {
+      return Derived{ checked_add( lhs.get(), rhs.get() ) };
+   }
+
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+   {
+      lhs.get() = checked_sub( lhs.get(), rhs.get() );
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+   {
+      return Derived{ checked_sub( lhs.get(), rhs.get() ) };
+   }
+};
+
+
+//---- <SaturatingArithmetic.h> -------------------------------------------------------------------
+
+//#include <Overflow.h>
+
+template< std::integral T >
+constexpr T saturating_add( T a, T b ) noexcept
+{
+   T result{};
+   return detail::add_overflow( a, b, result ) ? detail::saturated_add( a ) : result;
+}
+
+template< std::integral T >
+constexpr T saturating_sub( T a, T b ) noexcept
+{
+   T result{};
+   return detail::sub_overflow( a, b, result ) ? detail::saturated_sub( a ) : result;
+}
+
+// Addition and subtraction, which clamp the result to the range of the underlying type
+template< typename Derived >
+struct SaturatingArithmetic
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs ) noexcept
+   {
+      lhs.get() = saturating_add( lhs.get(), rhs.get() );
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs ) noexcept
+   {
+      return Derived{ saturating_add( lhs.get(), rhs.get() ) };
+   }
+
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs ) noexcept
+   {
+      lhs.get() = saturating_sub( lhs.get(), rhs.get() );
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs ) noexcept
+   {
+      return Derived{ saturating_sub( lhs.get(), rhs.get() ) };
+   }
+};
+
+
+//---- <WrappingArithmetic.h> ---------------------------------------------------------------------
+
+//#include <Overflow.h>
+
+template< std::integral T >
+constexpr T wrapping_add( T a, T b ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   return static_cast<T>( static_cast<U>(a) + static_cast<U>(b) );
+}
+
+template< std::integral T >
+constexpr T wrapping_sub( T a, T b ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   return static_cast<T>( static_cast<U>(a) - static_cast<U>(b) );
+}
+
+// Addition and subtraction with well-defined two's complement wrap-around (e.g. for sequence
+// numbers or hash values)
+template< typename Derived >
+struct WrappingArithmetic
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs ) noexcept
+   {
+      lhs.get() = wrapping_add( lhs.get(), rhs.get() );
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs ) noexcept
+   {
+      return Derived{ wrapping_add( lhs.get(), rhs.get() ) };
+   }
+
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs ) noexcept
+   {
+      lhs.get() = wrapping_sub( lhs.get(), rhs.get() );
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs ) noexcept
+   {
+      return Derived{ wrapping_sub( lhs.get(), rhs.get() ) };
+   }
+};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      return os << d.get();
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <HasSkill.h> -------------------------------------------------------------------------------
+
+// Checks whether the strong type 'S' provides the given skill (directly or via a compound skill)
+template< typename S, template<typename...> class Skill >
+concept HasSkill = std::derived_from< S, Skill<S> >;
+
+
+//---- <OverflowKernels.h> ------------------------------------------------------------------------
+
+//#include <CheckedArithmetic.h>
+//#include <HasSkill.h>
+//#include <SaturatingArithmetic.h>
+//#include <WrappingArithmetic.h>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+// The batch kernels don't branch per element. Instead, the overflow information of every element
+// is computed arithmetically and OR-reduced into a single flag, which keeps the loops
+// vectorizable ('__builtin_add_overflow()' prevents vectorization, at least for GCC). For each
+// element the most significant bit of the returned value is set in case of an overflow.
+namespace detail {
+
+template< std::integral T >
+constexpr std::make_unsigned_t<T> add_overflow_bits( T a, T b, T result ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   if constexpr( std::is_signed_v<T> ) {
+      return static_cast<U>( ( a ^ result ) & ( b ^ result ) );
+   }
+   else {
+      return static_cast<U>( -static_cast<U>( result < a ) );
+   }
+}
+
+template< std::integral T >
+constexpr std::make_unsigned_t<T> sub_overflow_bits( T a, T b, T result ) noexcept
+{
+   using U = std::make_unsigned_t<T>;
+   if constexpr( std::is_signed_v<T> ) {
+      return static_cast<U>( ( a ^ b ) & ( a ^ result ) );
+   }
+   else {
+      return static_cast<U>( -static_cast<U>( a < b ) );
+   }
+}
+
+template< std::unsigned_integral U >
+constexpr bool has_overflow( U bits ) noexcept
+{
+   return ( bits >> ( std::numeric_limits<U>::digits - 1 ) ) != U{};
+}
+
+} // namespace detail
+
+
+// result[i] = lhs[i] + rhs[i]; throws a 'std::overflow_error' exception if any of the additions
+// overflowed (in which case the content of 'result' is unspecified)
+template< typename S >
+   requires HasSkill<S,CheckedArithmetic>
+constexpr void add( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result )
+{
+   assert( lhs.size() == rhs.size() && lhs.size() == result.size() );
+
+   using T = typename S::value_type;
+   std::make_unsigned_t<T> overflow{};
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      T const a{ lhs[i].get() };
+      T const b{ rhs[i].get() };
+      T const sum{ wrapping_add( a, b ) };
+      overflow |= detail::add_overflow_bits( a, b, sum );
+      result[i].get() = sum;
+   }
+
+   if( detail::has_overflow( overflow ) ) {
+      throw std::overflow_error( "Integer overflow detected" );
+   }
+}
+
+// result[i] = lhs[i] - rhs[i]; throws a 'std::overflow_error' exception if any of the
+// subtractions overflowed (in which case the content of 'result' is unspecified)
+template< typename S >
+   requires HasSkill<S,CheckedArithmetic>
+constexpr void subtract( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result )
+{
+   assert( lhs.size() == rhs.size() && lhs.size() == result.size() );
+
+   using T = typename S::value_type;
+   std::make_unsigned_t<T> overflow{};
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      T const a{ lhs[i].get() };
+      T const b{ rhs[i].get() };
+      T const difference{ wrapping_sub( a, b ) };
+      overflow |= detail::sub_overflow_bits( a, b, difference );
+      result[i].get() = difference;
+   }
+
+   if( detail::has_overflow( overflow ) ) {
+      throw std::overflow_error( "Integer overflow detected" );
+   }
+}
+
+// result[i] = lhs[i] + rhs[i], clamped to the range of the underlying type; returns whether any
+// of the results was clamped
+template< typename S >
+   requires HasSkill<S,SaturatingArithmetic>
+constexpr bool add( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result ) noexcept
+{
+   assert( lhs.size() == rhs.size() && lhs.size() == result.size() );
+
+   using T = typename S::value_type;
+   std::make_unsigned_t<T> overflow{};
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      T const a{ lhs[i].get() };
+      T const b{ rhs[i].get() };
+      T const sum{ wrapping_add( a, b ) };
+      auto const bits{ detail::add_overflow_bits( a, b, sum ) };
+      overflow |= bits;
+      result[i].get() = detail::has_overflow( bits ) ? detail::saturated_add( a ) : sum;
+   }
+
+   return detail::has_overflow( overflow );
+}
+
+// result[i] = lhs[i] - rhs[i], clamped to the range of the underlying type; returns whether any
+// of the results was clamped
+template< typename S >
+   requires HasSkill<S,SaturatingArithmetic>
+constexpr bool subtract( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result ) noexcept
+{
+   assert( lhs.size() == rhs.size() && lhs.size() == result.size() );
+
+   using T = typename S::value_type;
+   std::make_unsigned_t<T> overflow{};
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      T const a{ lhs[i].get() };
+      T const b{ rhs[i].get() };
+      T const difference{ wrapping_sub( a, b ) };
+      auto const bits{ detail::sub_overflow_bits( a, b, difference ) };
+      overflow |= bits;
+      result[i].get() = detail::has_overflow( bits ) ? detail::saturated_sub( a ) : difference;
+   }
+
+   return detail::has_overflow( overflow );
+}
+
+// result[i] = lhs[i] + rhs[i] with two's complement wrap-around
+template< typename S >
+   requires HasSkill<S,WrappingArithmetic>
+constexpr void add( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result ) noexcept
+{
+   assert( lhs.size() == rhs.size() && lhs.size() == result.size() );
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      result[i].get() = wrapping_add( lhs[i].get(), rhs[i].get() );
+   }
+}
+
+// result[i] = lhs[i] - rhs[i] with two's complement wrap-around
+template< typename S >
+   requires HasSkill<S,WrappingArithmetic>
+constexpr void subtract( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result ) noexcept
+{
+   assert( lhs.size() == rhs.size() && lhs.size() == result.size() );
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      result[i].get() = wrapping_sub( lhs[i].get(), rhs[i].get() );
+   }
+}
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+//#include <CheckedArithmetic.h>
+
+template< typename T >
+using Meter = StrongType<T,struct MeterTag,CheckedArithmetic,Printable,EqualityComparable>;
+
+
+//---- <Intensity.h> ------------------------------------------------------------------------------
+
+//#include <SaturatingArithmetic.h>
+#include <cstdint>
+
+// Intensity of a pixel: brightening a bright pixel results in white instead of black
+using Intensity = StrongType<std::uint8_t,struct IntensityTag,SaturatingArithmetic,EqualityComparable>;
+
+
+//---- <SequenceNumber.h> -------------------------------------------------------------------------
+
+//#include <WrappingArithmetic.h>
+
+// Sequence number of a network protocol, which by definition wraps around
+using SequenceNumber = StrongType<std::uint16_t,struct SequenceNumberTag,WrappingArithmetic,Printable,EqualityComparable>;
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+int main()
+{
+   // Reaction to overflows
+   {
+      static_assert( Intensity{ 200U } + Intensity{ 100U } == Intensity{ 255U } );
+      static_assert( Intensity{ 100U } - Intensity{ 200U } == Intensity{ 0U } );
+      static_assert( SequenceNumber{ 65535U } + SequenceNumber{ 2U } == SequenceNumber{ 1U } );
+      static_assert( Meter<long>{ 100L } - Meter<long>{ 250L } == Meter<long>{ -150L } );
+
+      try {
+         Meter<long> m{ std::numeric_limits<long>::max() };
+         m += Meter<long>{ 1L };
+      }
+      catch( std::overflow_error const& ex ) {
+         std::cout << "\n Meter<long>: " << ex.what() << '\n';
+      }
+
+      std::vector<Intensity> const pixels{ Intensity{ 10U }, Intensity{ 128U }, Intensity{ 250U } };
+      std::vector<Intensity> const brighten( pixels.size(), Intensity{ 20U } );
+      std::vector<Intensity> result( pixels.size() );
+
+      bool const clamped = add( std::span{ pixels }, std::span{ brighten }, std::span{ result } );
+      std::cout << " Intensity:";
+      for( Intensity const& pixel : result ) {
+         std::cout << ' ' << +pixel.get();
+      }
+      std::cout << ( clamped ? " (clamped)\n" : "\n" );
+   }
+
+   // Runtime of the checked addition
+   {
+      constexpr std::size_t N = 10000U;
+      constexpr std::size_t repetitions = 10000U;
+
+      std::mt19937 rng{ std::random_device{}() };
+      std::uniform_int_distribution<long> dist{ -1000000L, 1000000L };
+
+      std::vector<long> a_raw( N ), b_raw( N ), c_raw( N );
+      std::generate( begin(a_raw), end(a_raw), [&]{ return dist(rng); } );
+      std::generate( begin(b_raw), end(b_raw), [&]{ return dist(rng); } );
+
+      std::vector<Meter<long>> a{}, b{}, c( N );
+      a.reserve( N );
+      b.reserve( N );
+      for( std::size_t i=0U; i<N; ++i ) {
+         a.emplace_back( a_raw[i] );
+         b.emplace_back( b_raw[i] );
+      }
+      std::vector<Meter<long>> d( a );  // Same start values for the batch addition
+
+      double const seconds_raw = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) {
+            for( std::size_t i=0U; i<N; ++i ) {
+               c_raw[i] = a_raw[i] + b_raw[i];
+            }
+            std::swap( a_raw, c_raw );
+         }
+      } ) / repetitions;
+
+      double const seconds_element = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) {
+            for( std::size_t i=0U; i<N; ++i ) {
+               c[i] = a[i] + b[i];
+            }
+            std::swap( a, c );
+         }
+      } ) / repetitions;
+
+      double const seconds_batch = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) {
+            add( std::span<Meter<long> const>{ d }, std::span<Meter<long> const>{ b }, std::span{ c } );
+            std::swap( d, c );
+         }
+      } ) / repetitions;
+
+      std::cout << "\n Addition of " << N << " values:"
+                << "\n  long (unchecked):          " << seconds_raw*1E6 << "us (checksum=" << a_raw[N/2U] << ")"
+                << "\n  Meter<long> (per element): " << seconds_element*1E6 << "us (checksum=" << a[N/2U] << ")"
+                << "\n  Meter<long> (batch):       " << seconds_batch*1E6 << "us (checksum=" << d[N/2U] << ")\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,577 @@
+/**************************************************************************************************
+*
+* \file StrongType_Relocation.cpp
+* \brief C++ Training - Programming example about trivially relocatable strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: For strong types with non-trivial underlying types (e.g. 'std::unique_ptr' or
+*       'std::string') 'std::vector' moves and destroys the elements one by one on every
+*       reallocation and on every erase operation. However, many types can be relocated (i.e.
+*       moved to a new address and destroyed at the old address) by copying their bytes.
+*       Provide
+*        - an 'is_trivially_relocatable' trait, which is true for a 'StrongType' if and only if
+*          its underlying type is trivially relocatable
+*        - a 'RelocatingVector<T>' class template, which relocates trivially relocatable elements
+*          via 'std::memcpy()'/'std::memmove()' on reallocation, in 'erase()' and in 'erase_if()'
+*
+* Step 1: Compare the runtime of 'std::vector' and 'RelocatingVector'.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      return os << d.get();
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <HasSkill.h> -------------------------------------------------------------------------------
+
+// Checks whether the strong type 'S' provides the given skill (directly or via a compound skill)
+template< typename S, template<typename...> class Skill >
+concept HasSkill = std::derived_from< S, Skill<S> >;
+
+
+//---- <TriviallyRelocatable.h> -------------------------------------------------------------------
+
+//#include <StrongType.h>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// A type is trivially relocatable if moving an object to a new address and destroying it at the
+// old address is equivalent to copying its bytes. This is true for all trivially copyable types
+// and for many standard library types, which do not store pointers to themselves. Types can opt
+// in by specializing the trait.
+template< typename T >
+struct is_trivially_relocatable
+   : public std::bool_constant< std::is_trivially_copyable_v<T> >
+{};
+
+template< typename T >
+struct is_trivially_relocatable< std::unique_ptr<T> >
+   : public std::true_type
+{};
+
+template< typename T >
+struct is_trivially_relocatable< std::shared_ptr<T> >
+   : public std::true_type
+{};
+
+// The checked containers of the debug modes of libstdc++ and MSVC are registered with their
+// iterators and therefore cannot be relocated
+#if !defined(_GLIBCXX_DEBUG) && ( !defined(_ITERATOR_DEBUG_LEVEL) || _ITERATOR_DEBUG_LEVEL == 0 )
+template< typename T >
+struct is_trivially_relocatable< std::vector<T> >
+   : public std::true_type
+{};
+#endif
+
+// The 'std::string' of libstdc++ stores a pointer to its internal buffer (small string
+// optimization), the 'std::string' of libc++ does not
+#if defined(_LIBCPP_VERSION)
+template<>
+struct is_trivially_relocatable< std::string >
+   : public std::true_type
+{};
+#endif
+
+// A strong type is trivially relocatable if and only if its underlying type is (all skills are
+// empty base classes)
+template< typename T, typename Tag, template<typename...> class... Skills >
+struct is_trivially_relocatable< StrongType<T,Tag,Skills...> >
+   : public is_trivially_relocatable<T>
+{};
+
+template< typename T >
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+
+//---- <Relocate.h> -------------------------------------------------------------------------------
+
+//#include <TriviallyRelocatable.h>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+// Relocates the objects in the range [first,first+n) to the (uninitialized) storage starting at
+// 'dest'. Afterwards the objects in the source range are destroyed. Overlapping ranges are only
+// allowed if 'dest' precedes 'first'. Relocating a range onto itself has no effect (instead of
+// moving every object onto itself).
+template< typename T >
+void relocate( T* first, std::size_t n, T* dest ) noexcept
+{
+   static_assert( is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T> );
+
+   if( dest == first ) return;
+
+   if constexpr( is_trivially_relocatable_v<T> ) {
+      if( n != 0U ) {
+         std::memmove( static_cast<void*>( dest ), static_cast<void const*>( first ), n*sizeof(T) );
+      }
+   }
+   else {
+      for( std::size_t i=0U; i<n; ++i ) {
+         std::construct_at( dest+i, std::move(first[i]) );
+         std::destroy_at( first+i );
+      }
+   }
+}
+
+
+//---- <RelocatingVector.h> -----------------------------------------------------------------------
+
+//#include <Relocate.h>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+
+// Minimal vector, which relocates trivially relocatable elements by copying their bytes. Other
+// element types are required to be nothrow move constructible.
+template< typename T >
+   requires ( is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T> )
+class RelocatingVector
+{
+ public:
+   using value_type = T;
+   using size_type = std::size_t;
+   using iterator = T*;
+   using const_iterator = T const*;
+
+   RelocatingVector() = default;
+
+   RelocatingVector( std::initializer_list<T> list ) requires std::copy_constructible<T>
+   {
+      reserve( list.size() );
+      for( T const& value : list ) {
+         std::construct_at( data_+size_, value );
+         ++size_;
+      }
+   }
+
+   RelocatingVector( RelocatingVector const& ) = delete;
+   RelocatingVector& operator=( RelocatingVector const& ) = delete;
+
+   RelocatingVector( RelocatingVector&& other ) noexcept
+      : data_    { std::exchange( other.data_, nullptr ) }
+      , size_    { std::exchange( other.size_, 0U ) }
+      , capacity_{ std::exchange( other.capacity_, 0U ) }
+   {}
+
+   RelocatingVector& operator=( RelocatingVector&& other ) noexcept
+   {
+      RelocatingVector tmp{ std::move(other) };
+      swap( tmp );
+      return *this;
+   }
+
+   ~RelocatingVector()
+   {
+      clear();
+      deallocate( data_, capacity_ );
+   }
+
+   [[nodiscard]] size_type size()     const noexcept { return size_; }
+   [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+   [[nodiscard]] bool      empty()    const noexcept { return size_ == 0U; }
+
+   T*       data()       noexcept { return data_; }
+   T const* data() const noexcept { return data_; }
+
+   T&       operator[]( size_type index )       noexcept { return data_[index]; }
+   T const& operator[]( size_type index ) const noexcept { return data_[index]; }
+
+   iterator       begin()       noexcept { return data_; }
+   const_iterator begin() const noexcept { return data_; }
+   iterator       end()         noexcept { return data_+size_; }
+   const_iterator end()   const noexcept { return data_+size_; }
+
+   void reserve( size_type capacity )
+   {
+      if( capacity <= capacity_ ) return;
+
+      T* const tmp{ allocate( capacity ) };
+      relocate( data_, size_, tmp );
+      deallocate( data_, capacity_ );
+      data_ = tmp;
+      capacity_ = capacity;
+   }
+
+   template< typename... Args >
+   T& emplace_back( Args&&... args )
+   {
+      if( size_ == capacity_ ) {
+         // The new element is constructed before the relocation, since 'args' might refer to
+         // an element of the vector
+         size_type const capacity{ capacity_ == 0U ? 4U : 2U*capacity_ };
+         T* const tmp{ allocate( capacity ) };
+         try {
+            std::construct_at( tmp+size_, std::forward<Args>(args)... );
+         }
+         catch( ... ) {
+            deallocate( tmp, capacity );
+            throw;
+         }
+         relocate( data_, size_, tmp );
+         deallocate( data_, capacity_ );
+         data_ = tmp;
+         capacity_ = capacity;
+      }
+      else {
+         std::construct_at( data_+size_, std::forward<Args>(args)... );
+      }
+
+      return data_[size_++];
+   }
+
+   void push_back( T const& value ) { emplace_back( value ); }
+   void push_back( T&& value ) { emplace_back( std::move(value) ); }
+
+   void pop_back() noexcept
+   {
+      std::destroy_at( data_ + --size_ );
+   }
+
+   iterator erase( const_iterator pos ) noexcept
+   {
+      T* const p{ data_ + ( pos - data_ ) };
+      std::destroy_at( p );
+      relocate( p+1, static_cast<size_type>( end() - (p+1) ), p );
+      --size_;
+      return p;
+   }
+
+   void clear() noexcept
+   {
+      std::destroy( begin(), end() );
+      size_ = 0U;
+   }
+
+   void swap( RelocatingVector& other ) noexcept
+   {
+      std::swap( data_, other.data_ );
+      std::swap( size_, other.size_ );
+      std::swap( capacity_, other.capacity_ );
+   }
+
+   // Erases all elements satisfying the given predicate. The removed elements are destroyed and
+   // every run of remaining elements is relocated in one step. Returns the number of erased
+   // elements.
+   template< typename Pred >
+   friend size_type erase_if( RelocatingVector& v, Pred pred )
+   {
+      size_type const size{ v.size_ };
+      size_type write{ 0U };    // Number of remaining elements at the front
+      size_type pending{ 0U };  // First remaining element, which has not been relocated yet
+      size_type read{ 0U };
+
+      // In case the predicate throws, the not yet processed elements are kept
+      auto const compact = [&]( size_type last ) noexcept {
+         relocate( v.data_+pending, last-pending, v.data_+write );
+         write += last-pending;
+      };
+
+      try {
+         for( ; read<size; ++read ) {
+            if( pred( std::as_const( v.data_[read] ) ) ) {
+               compact( read );
+               std::destroy_at( v.data_+read );
+               pending = read+1U;
+            }
+         }
+      }
+      catch( ... ) {
+         compact( size );
+         v.size_ = write;
+         throw;
+      }
+
+      compact( size );
+      v.size_ = write;
+
+      return size - write;
+   }
+
+ private:
+   static T* allocate( size_type n )
+   {
+      return std::allocator<T>{}.allocate( n );
+   }
+
+   // The size must be the number of elements passed to 'allocate()'
+   static void deallocate( T* ptr, size_type n ) noexcept
+   {
+      if( ptr ) std::allocator<T>{}.deallocate( ptr, n );
+   }
+
+   T* data_{ nullptr };
+   size_type size_{ 0U };
+   size_type capacity_{ 0U };
+};
+
+
+//---- <Name.h> -----------------------------------------------------------------------------------
+
+using Name = StrongType<std::string,struct NameTag,Printable,EqualityComparable>;
+
+
+//---- <Handle.h> ---------------------------------------------------------------------------------
+
+struct Resource { int id{}; };
+
+using Handle = StrongType<std::unique_ptr<Resource>,struct HandleTag,EqualityComparable>;
+
+static_assert( is_trivially_relocatable_v<Handle> );
+static_assert( is_trivially_relocatable_v< StrongType<double,struct MeterTag,IntegralArithmetic> > );
+static_assert( is_trivially_relocatable_v<Name> == is_trivially_relocatable_v<std::string> );
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+// Runtime of growing a vector of handles (without 'reserve()'), of erasing the front element
+// and of erasing 10% of all handles
+template< typename Vector >
+void benchmark( char const* name )
+{
+   constexpr std::size_t N = 1000000U;
+   constexpr std::size_t front_erasures = 100U;
+
+   std::vector<Handle> handles{};
+   handles.reserve( N );
+   for( std::size_t i=0U; i<N; ++i ) {
+      handles.emplace_back( std::make_unique<Resource>( static_cast<int>(i) ) );
+   }
+
+   Vector v{};
+
+   double const seconds_growth = measure( [&]{
+      for( Handle& handle : handles ) {
+         v.push_back( std::move(handle) );
+      }
+   } );
+
+   double const seconds_erase = measure( [&]{
+      for( std::size_t i=0U; i<front_erasures; ++i ) {
+         v.erase( v.begin() );
+      }
+   } );
+
+   std::size_t erased{};
+   double const seconds_erase_if = measure( [&]{
+      erased = erase_if( v, []( Handle const& h ){ return h.get()->id % 10 == 3; } );
+   } );
+
+   std::cout << "\n " << name << " (" << N << " handles):"
+             << "\n  growth:     " << seconds_growth*1E3 << "ms"
+             << "\n  erase():    " << seconds_erase*1E3 << "ms (" << front_erasures << " times)"
+             << "\n  erase_if(): " << seconds_erase_if*1E3 << "ms (" << erased << " erased)\n";
+}
+
+int main()
+{
+   {
+      RelocatingVector<Name> names{ Name{ "Alice" }, Name{ "Bob" }, Name{ "Carol" }, Name{ "Dave" } };
+      names.emplace_back( "A name that does not fit into the small string buffer" );
+
+      erase_if( names, []( Name const& name ){ return name.get().size() == 3U; } );
+
+      std::cout << "\n Names (trivially relocatable: " << std::boolalpha
+                << is_trivially_relocatable_v<Name> << "):";
+      for( Name const& name : names ) {
+         std::cout << ' ' << name;
+      }
+      std::cout << "\n";
+   }
+
+   // Names that do not fit into the small string buffer own heap memory, so a broken relocation
+   // (e.g. an element moved onto itself) is visible independent of the string implementation
+   {
+      std::string const prefix( 40U, '#' );
+      std::vector<std::string> expected{};
+      RelocatingVector<Name> names{};
+      for( int i=0; i<10; ++i ) {
+         expected.push_back( prefix + std::to_string(i) );
+         names.emplace_back( expected.back() );
+      }
+
+      auto const matches = [&]{
+         return names.size() == expected.size() &&
+                std::equal( names.begin(), names.end(), expected.begin(),
+                            []( Name const& name, std::string const& s ){ return name.get() == s; } );
+      };
+
+      // Nothing erased: every element stays in place
+      erase_if( names, []( Name const& ){ return false; } );
+      bool valid = matches();
+
+      // The first elements stay in place, the following runs are relocated
+      erase_if( names, []( Name const& name ){ return name.get().back() % 3 == 2; } );
+      std::erase_if( expected, []( std::string const& s ){ return s.back() % 3 == 2; } );
+      valid = valid && matches();
+
+      if( !valid ) {
+         std::cerr << "\n ERROR: erase_if() corrupted the long names\n";
+         return EXIT_FAILURE;
+      }
+   }
+
+   benchmark< std::vector<Handle> >( "std::vector" );
+   benchmark< RelocatingVector<Handle> >( "RelocatingVector" );
+
+   std::cout << "\n";
+
+   return EXIT_SUCCESS;
+}
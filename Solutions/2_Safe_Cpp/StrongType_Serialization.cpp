@@ -0,0 +1,523 @@
+/**************************************************************************************************
+*
+* \file StrongType_Serialization.cpp
+* \brief C++ Training - Programming example about the serialization of strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Provide a 'Serializable' skill, which connects strong types to the (external)
+*       'fs::Serializer'. A span of strong types is written with a header (a type identifier
+*       derived from the tag and the underlying type, followed by the number of elements) and
+*       can only be read back as the same strong type. Strong types with a trivially copyable
+*       underlying type are written and read by a single 'std::memcpy()', all other strong types
+*       fall back to the element-wise encoding of the underlying values.
+*
+* Step 1: Compare the runtime of the bulk serialization and the element-wise serialization.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <FastSerialization.h> (external) -----------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+// ... and many more serialization-related headers
+
+namespace fs {
+
+class Serializer
+{
+ public:
+   std::string to_string() const
+   {
+      return std::string( buffer_.data(), buffer_.size() );
+   }
+
+   std::span<char const> data() const noexcept { return buffer_; }
+
+   void reserve( std::size_t capacity ) { buffer_.reserve( capacity ); }
+
+   // Appends the given bytes unchanged
+   void write( void const* data, std::size_t size )
+   {
+      std::size_t const old_size = buffer_.size();
+      buffer_.resize( old_size + size );
+      std::memcpy( buffer_.data() + old_size, data, size );
+   }
+
+ private:
+   std::vector<char> buffer_;
+
+   template< typename T >
+      requires std::is_arithmetic_v<T>
+   friend Serializer& operator<<( Serializer& serializer, T value )
+   {
+      serializer.write( &value, sizeof(T) );
+      return serializer;
+   }
+
+   friend Serializer& operator<<( Serializer& serializer, std::string const& value )
+   {
+      serializer << static_cast<std::uint64_t>( value.size() );
+      serializer.write( value.data(), value.size() );
+      return serializer;
+   }
+};
+
+class Deserializer
+{
+ public:
+   explicit Deserializer( std::span<char const> buffer ) noexcept
+      : buffer_( buffer )
+   {}
+
+   std::size_t remaining() const noexcept { return buffer_.size() - position_; }
+
+   // Extracts the given number of bytes unchanged
+   void read( void* data, std::size_t size )
+   {
+      if( size > remaining() ) {
+         throw std::runtime_error( "Unexpected end of buffer" );
+      }
+      std::memcpy( data, buffer_.data() + position_, size );
+      position_ += size;
+   }
+
+ private:
+   std::span<char const> buffer_;
+   std::size_t position_{};
+
+   template< typename T >
+      requires std::is_arithmetic_v<T>
+   friend Deserializer& operator>>( Deserializer& deserializer, T& value )
+   {
+      deserializer.read( &value, sizeof(T) );
+      return deserializer;
+   }
+
+   friend Deserializer& operator>>( Deserializer& deserializer, std::string& value )
+   {
+      std::uint64_t size{};
+      deserializer >> size;
+      if( size > deserializer.remaining() ) {
+         throw std::runtime_error( "Unexpected end of buffer" );
+      }
+      value.resize( static_cast<std::size_t>( size ) );
+      deserializer.read( value.data(), value.size() );
+      return deserializer;
+   }
+};
+
+} // namespace fs
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      os << d.get();
+      return os;
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <Comparable.h> -----------------------------------------------------------------------------
+
+template< typename Derived >
+struct Comparable
+   : public EqualityComparable<Derived>
+{
+   friend constexpr auto operator<=>( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() <=> rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <HasSkill.h> -------------------------------------------------------------------------------
+
+// Checks whether the strong type 'S' provides the given skill (directly or via a compound skill)
+template< typename S, template<typename...> class Skill >
+concept HasSkill = std::derived_from< S, Skill<S> >;
+
+
+//---- <TypeId.h> ---------------------------------------------------------------------------------
+
+//#include <StrongType.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+// The portable name of a non-arithmetic underlying type is given by a specialization of
+// 'TypeName' with a static 'name' data member
+template< typename T >
+struct TypeName
+{};
+
+template<>
+struct TypeName<std::string>
+{
+   static constexpr std::string_view name{ "string" };
+};
+
+namespace detail {
+
+// 64-bit FNV-1a hash
+constexpr std::uint64_t fnv1a( std::string_view str, std::uint64_t hash = 14695981039346656037ULL ) noexcept
+{
+   for( char const c : str ) {
+      hash ^= static_cast<unsigned char>( c );
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+// Hashes the portable description of the given underlying type: arithmetic types are described
+// by their kind, number of value bits and size (e.g. "f", 53, 8 for an IEEE 754 'double'), all
+// other types by their 'TypeName'
+template< typename T >
+constexpr std::uint64_t fnv1a_type( std::uint64_t hash ) noexcept
+{
+   if constexpr( std::is_arithmetic_v<T> ) {
+      char const kind = std::is_same_v<T,bool>     ? 'b'
+                      : std::is_floating_point_v<T> ? 'f'
+                      : std::is_signed_v<T>         ? 'i' : 'u';
+      char const description[]{ kind, static_cast<char>( std::numeric_limits<T>::digits )
+                              , static_cast<char>( sizeof(T) ) };
+      return fnv1a( std::string_view{ description, sizeof(description) }, hash );
+   }
+   else {
+      static_assert( requires { { TypeName<T>::name } -> std::convertible_to<std::string_view>; },
+                     "The underlying type requires a 'TypeName' specialization" );
+      return fnv1a( TypeName<T>::name, hash );
+   }
+}
+
+} // namespace detail
+
+// The name of a tag is given by a static 'name' data member
+template< typename Tag >
+constexpr std::string_view tag_name() noexcept
+{
+   static_assert( requires { { Tag::name } -> std::convertible_to<std::string_view>; },
+                  "The tag requires a static 'name' data member" );
+   return Tag::name;
+}
+
+// The identifier of a strong type written into the header of serialized data. It is derived
+// from the tag and the underlying type, i.e. 'Meter<double>' and 'Meter<float>' are different.
+// Since it only depends on names and portable properties of the types (and not on the names
+// generated by the compiler), it is the same for all compilers.
+template< typename S >
+constexpr std::uint64_t type_id_v = 0U;
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr std::uint64_t type_id_v< StrongType<T,Tag,Skills...> > =
+   detail::fnv1a_type<T>( detail::fnv1a( tag_name<Tag>() ) );
+
+
+//---- <Serializable.h> ---------------------------------------------------------------------------
+
+//#include <FastSerialization.h>
+//#include <HasSkill.h>
+//#include <TypeId.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Serialization of a single strong type value (without header)
+template< typename Derived >
+struct Serializable
+{
+   friend fs::Serializer& operator<<( fs::Serializer& serializer, Derived const& d )
+   {
+      return serializer << d.get();
+   }
+
+   friend fs::Deserializer& operator>>( fs::Deserializer& deserializer, Derived& d )
+   {
+      return deserializer >> d.get();
+   }
+};
+
+// A strong type can be serialized in bulk if its object representation is the object
+// representation of the underlying value (i.e. it can be copied byte by byte).
+template< typename S >
+concept BulkSerializable =
+   HasSkill<S,Serializable> &&
+   std::is_trivially_copyable_v<S> &&
+   std::is_trivially_copyable_v<typename S::value_type> &&
+   std::is_standard_layout_v<S> &&
+   sizeof(S) == sizeof(typename S::value_type);
+
+// Writes the given values, preceded by the type identifier and the number of values
+template< typename S >
+   requires HasSkill<S,Serializable>
+void serialize( fs::Serializer& serializer, std::span<S const> values )
+{
+   serializer << type_id_v<S> << static_cast<std::uint64_t>( values.size() );
+
+   if constexpr( BulkSerializable<S> ) {
+      serializer.write( values.data(), values.size_bytes() );
+   }
+   else {
+      for( auto const& value : values ) {
+         serializer << value;
+      }
+   }
+}
+
+// Reads values written by 'serialize()'. The data has to be written for the same strong type.
+template< typename S >
+   requires HasSkill<S,Serializable>
+std::vector<S> deserialize( fs::Deserializer& deserializer )
+{
+   std::uint64_t id{};
+   std::uint64_t size{};
+   deserializer >> id >> size;
+
+   if( id != type_id_v<S> ) {
+      throw std::runtime_error( "Type mismatch detected" );
+   }
+
+   std::vector<S> values{};
+
+   if constexpr( BulkSerializable<S> ) {
+      if( size > deserializer.remaining() / sizeof(S) ) {
+         throw std::runtime_error( "Unexpected end of buffer" );
+      }
+      values.resize( static_cast<std::size_t>( size ) );
+      deserializer.read( values.data(), values.size()*sizeof(S) );
+   }
+   else {
+      values.reserve( std::min<std::uint64_t>( size, deserializer.remaining() ) );
+      for( std::uint64_t i=0U; i<size; ++i ) {
+         deserializer >> values.emplace_back();
+      }
+   }
+
+   return values;
+}
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+//#include <Serializable.h>
+#include <string_view>
+
+struct MeterTag
+{
+   static constexpr std::string_view name{ "Meter" };
+};
+
+template< typename T >
+using Meter = StrongType<T,MeterTag,Printable,EqualityComparable,Serializable>;
+
+
+//---- <Kilometer.h> ------------------------------------------------------------------------------
+
+//#include <Serializable.h>
+#include <string_view>
+
+struct KilometerTag
+{
+   static constexpr std::string_view name{ "Kilometer" };
+};
+
+template< typename T >
+using Kilometer = StrongType<T,KilometerTag,Printable,EqualityComparable,Serializable>;
+
+
+//---- <Name.h> -----------------------------------------------------------------------------------
+
+//#include <Serializable.h>
+#include <string>
+#include <string_view>
+
+struct NameTag
+{
+   static constexpr std::string_view name{ "Name" };
+};
+
+using Name = StrongType<std::string,NameTag,Printable,EqualityComparable,Serializable>;
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+int main()
+{
+   static_assert(  BulkSerializable< Meter<double> > );
+   static_assert( !BulkSerializable< Name > );
+   static_assert( type_id_v< Meter<double> > != type_id_v< Meter<float> > );
+   static_assert( type_id_v< Meter<double> > != type_id_v< Kilometer<double> > );
+   static_assert( type_id_v< Meter<std::int64_t> > != type_id_v< Meter<std::uint64_t> > );
+   static_assert( type_id_v< Meter<std::int32_t> > != type_id_v< Meter<std::int64_t> > );
+   static_assert( type_id_v< Meter<double> > == 0xD13CFB0EA370FDC9ULL );  // For every compiler (IEEE 754)
+
+   // Round trip of trivially copyable and non-trivial strong types
+   {
+      std::vector<Meter<double>> const meters{ Meter<double>{ 1.5 }, Meter<double>{ 2.5 } };
+      std::vector<Name> const names{ Name{ "Alice" }, Name{ "Bob" } };
+
+      fs::Serializer serializer{};
+      serialize( serializer, std::span<Meter<double> const>{ meters } );
+      serialize( serializer, std::span<Name const>{ names } );
+
+      fs::Deserializer deserializer{ serializer.data() };
+      auto const meters_copy = deserialize<Meter<double>>( deserializer );
+      auto const names_copy = deserialize<Name>( deserializer );
+
+      std::cout << "\n meters: " << std::boolalpha << ( meters == meters_copy )
+                << "\n names : " << ( names == names_copy ) << "\n";
+
+      // The header prevents reading the data as a different strong type
+      try {
+         fs::Deserializer wrong{ serializer.data() };
+         static_cast<void>( deserialize<Kilometer<double>>( wrong ) );
+      }
+      catch( std::runtime_error const& ex ) {
+         std::cout << " Kilometer<double>: " << ex.what() << "\n";
+      }
+   }
+
+   // Bulk vs. element-wise serialization
+   {
+      constexpr std::size_t N = 10000000U;
+
+      std::random_device rd{};
+      std::mt19937 mt{ rd() };
+      std::uniform_real_distribution<double> dist{ 0.0, 100.0 };
+
+      std::vector<Meter<double>> meters( N );
+      std::ranges::generate( meters, [&]{ return Meter<double>{ dist(mt) }; } );
+
+      fs::Serializer elementwise{};
+      fs::Serializer bulk{};
+
+      double const seconds_elementwise = measure( [&]{
+         elementwise << type_id_v<Meter<double>> << static_cast<std::uint64_t>( N );
+         for( auto const& meter : meters ) {
+            elementwise << meter;
+         }
+      } );
+
+      double const seconds_bulk = measure( [&]{
+         serialize( bulk, std::span<Meter<double> const>{ meters } );
+      } );
+
+      std::cout << "\n Serialization of " << N << " values:"
+                << "\n  element-wise : " << seconds_elementwise * 1E3 << "ms"
+                << "\n  bulk         : " << seconds_bulk * 1E3 << "ms"
+                << "\n  identical    : " << ( elementwise.to_string() == bulk.to_string() ) << "\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
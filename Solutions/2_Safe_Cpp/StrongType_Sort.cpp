@@ -0,0 +1,455 @@
+/**************************************************************************************************
+*
+* \file StrongType_Sort.cpp
+* \brief C++ Training - Programming example about hashing and radix sorting of strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Strong types cannot be used as keys of 'std::unordered_map' and cannot be sorted, since
+*       they neither provide a hash function nor an ordering. Provide
+*        - a 'Hashable' skill, which enables 'std::hash' for the strong type based on a fast
+*          integer hash of the underlying value
+*        - an 'Orderable' skill, which provides the comparison operators and a monotone unsigned
+*          key ('radix_key()') of the underlying value
+*       Based on the 'Orderable' skill, implement an LSD radix sort for spans of strong types.
+*
+* Step 1: Compare the runtime of the radix sort with 'std::ranges::sort()'.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      return os << d.get();
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <HasSkill.h> -------------------------------------------------------------------------------
+
+// Checks whether the strong type 'S' provides the given skill (directly or via a compound skill)
+template< typename S, template<typename...> class Skill >
+concept HasSkill = std::derived_from< S, Skill<S> >;
+
+
+//---- <RadixKey.h> -------------------------------------------------------------------------------
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace detail {
+
+// Maps an arithmetic value to an unsigned integer of the same size, such that the order of the
+// unsigned integers is the same as the order of the values ('a < b' implies 'key(a) < key(b)').
+// For floating point values the order is the total order of IEEE 754, i.e. '-0.0' precedes
+// '+0.0' and NaNs are placed at both ends.
+template< typename T >
+   requires std::integral<T> && ( !std::same_as<T,bool> )
+constexpr auto radix_key( T value ) noexcept
+{
+   using Key = std::make_unsigned_t<T>;
+
+   if constexpr( std::is_signed_v<T> ) {
+      return static_cast<Key>( static_cast<Key>( value ) ^ ( Key{1} << (std::numeric_limits<Key>::digits-1) ) );
+   }
+   else {
+      return value;
+   }
+}
+
+template< typename T >
+   requires std::floating_point<T> && std::numeric_limits<T>::is_iec559
+         && ( sizeof(T) == sizeof(std::uint32_t) || sizeof(T) == sizeof(std::uint64_t) )
+constexpr auto radix_key( T value ) noexcept
+{
+   using Key = std::conditional_t< sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t >;
+
+   constexpr Key signBit{ Key{1} << (std::numeric_limits<Key>::digits-1) };
+   Key const bits{ std::bit_cast<Key>( value ) };
+
+   // Negative values: flip all bits (reverses their order), positive values: set the sign bit
+   return static_cast<Key>( ( bits & signBit ) ? ~bits : ( bits | signBit ) );
+}
+
+} // namespace detail
+
+
+template< typename T >
+concept RadixSortable = requires ( T value ) { detail::radix_key( value ); };
+
+
+//---- <Hashable.h> -------------------------------------------------------------------------------
+
+//#include <RadixKey.h>
+#include <cstddef>
+#include <functional>
+
+namespace detail {
+
+// Finalizer of MurmurHash3: every bit of the input affects every bit of the result. In contrast,
+// 'std::hash' of integral values is the identity function for many standard libraries.
+constexpr std::uint64_t hash_mix( std::uint64_t h ) noexcept
+{
+   h ^= h >> 33U;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33U;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33U;
+   return h;
+}
+
+} // namespace detail
+
+template< typename Derived >
+struct Hashable
+{
+   [[nodiscard]] constexpr std::size_t hash() const noexcept
+      requires RadixSortable<typename Derived::value_type>
+   {
+      auto value = static_cast<Derived const&>( *this ).get();
+
+      // '-0.0' and '+0.0' compare equal and therefore require the same hash value
+      if constexpr( std::floating_point<decltype(value)> ) {
+         if( value == decltype(value){} ) value = decltype(value){};
+      }
+
+      return static_cast<std::size_t>( detail::hash_mix( detail::radix_key( value ) ) );
+   }
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+   requires HasSkill< StrongType<T,Tag,Skills...>, Hashable >
+struct std::hash< StrongType<T,Tag,Skills...> >
+{
+   std::size_t operator()( StrongType<T,Tag,Skills...> const& value ) const noexcept
+   {
+      return value.hash();
+   }
+};
+
+
+//---- <Orderable.h> ------------------------------------------------------------------------------
+
+//#include <RadixKey.h>
+#include <compare>
+
+template< typename Derived >
+struct Orderable
+{
+   template< typename D = Derived >
+   friend constexpr auto operator<=>( Derived const& lhs, Derived const& rhs )
+      requires std::three_way_comparable<typename D::value_type>
+   {
+      return lhs.get() <=> rhs.get();
+   }
+
+   // Monotone unsigned key of the underlying value (see 'detail::radix_key()')
+   [[nodiscard]] constexpr auto radix_key() const noexcept
+      requires RadixSortable<typename Derived::value_type>
+   {
+      return detail::radix_key( static_cast<Derived const&>( *this ).get() );
+   }
+};
+
+
+//---- <RadixSort.h> ------------------------------------------------------------------------------
+
+//#include <Orderable.h>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+template< typename S >
+concept RadixSortableStrongType =
+   HasSkill<S,Orderable> && RadixSortable<typename S::value_type> && std::is_nothrow_move_assignable_v<S>;
+
+// Stable LSD radix sort. 64-bit keys are sorted with 11-bit digits (6 instead of 8 passes, the
+// histograms still fit into the L1 cache), all other keys with 8-bit digits. All histograms are
+// computed in a single pass and every pass in which all elements have the same digit is skipped.
+// Small spans are sorted with an insertion sort.
+template< RadixSortableStrongType S >
+void radix_sort( std::span<S> values )
+{
+   using Key = decltype( std::declval<S const&>().radix_key() );
+
+   constexpr std::size_t bits{ std::numeric_limits<Key>::digits > 32 ? 11U : 8U };
+   constexpr std::size_t digits{ ( std::numeric_limits<Key>::digits + bits - 1U ) / bits };
+   constexpr std::size_t buckets{ std::size_t{1} << bits };
+   constexpr Key mask{ buckets - 1U };
+   constexpr std::size_t threshold{ 64U };
+
+   std::size_t const n{ values.size() };
+
+   if( n <= threshold ) {
+      for( std::size_t i=1U; i<n; ++i ) {
+         S tmp{ std::move(values[i]) };
+         Key const key{ tmp.radix_key() };
+         std::size_t j{ i };
+         for( ; j>0U && key < values[j-1U].radix_key(); --j ) {
+            values[j] = std::move(values[j-1U]);
+         }
+         values[j] = std::move(tmp);
+      }
+      return;
+   }
+
+   std::vector<std::array<std::size_t,buckets>> counts( digits );
+
+   for( S const& value : values ) {
+      Key const key{ value.radix_key() };
+      for( std::size_t d=0U; d<digits; ++d ) {
+         ++counts[d][( key >> (bits*d) ) & mask];
+      }
+   }
+
+   std::vector<S> buffer( n );
+   std::span<S> from{ values };
+   std::span<S> to{ buffer };
+
+   for( std::size_t d=0U; d<digits; ++d )
+   {
+      auto& count = counts[d];
+
+      // All elements have the same digit: the pass would not change the order
+      if( std::ranges::find( count, n ) != end(count) ) continue;
+
+      std::size_t offset{ 0U };
+      for( std::size_t& c : count ) {
+         offset += std::exchange( c, offset );
+      }
+
+      for( S& value : from ) {
+         std::size_t const digit{ static_cast<std::size_t>( ( value.radix_key() >> (bits*d) ) & mask ) };
+         to[count[digit]++] = std::move(value);
+      }
+
+      std::swap( from, to );
+   }
+
+   if( from.data() != values.data() ) {
+      std::ranges::move( from, values.begin() );
+   }
+}
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+template< typename T >
+using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Printable,EqualityComparable,Hashable,Orderable>;
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+template< typename T >
+void benchmark( std::vector<Meter<T>> const& meters, char const* name )
+{
+   auto sorted1 = meters;
+   auto sorted2 = meters;
+
+   double const seconds_std = measure( [&]{
+      std::ranges::sort( sorted1 );
+   } );
+
+   double const seconds_radix = measure( [&]{
+      radix_sort( std::span<Meter<T>>{ sorted2 } );
+   } );
+
+   std::cout << "\n Sorting of " << meters.size() << " Meter<" << name << "> values:"
+             << "\n  std::ranges::sort(): " << seconds_std*1E3 << "ms"
+             << "\n  radix_sort():        " << seconds_radix*1E3 << "ms"
+             << "\n  Speedup:             " << seconds_std/seconds_radix
+             << "\n  Same result:         " << std::boolalpha << ( sorted1 == sorted2 ) << "\n";
+}
+
+int main()
+{
+   // Meters as keys of an unordered map
+   {
+      std::unordered_map<Meter<long>,std::string> landmarks{
+         { Meter<long>{ 0L }, "Start" },
+         { Meter<long>{ 21097L }, "Half marathon" },
+         { Meter<long>{ 42195L }, "Finish" } };
+
+      std::cout << "\n 21097m: " << landmarks.at( Meter<long>{ 21097L } ) << "\n";
+   }
+
+   // Radix sort vs. comparison sort
+   {
+      constexpr std::size_t N = 5000000U;
+
+      std::mt19937_64 rng{ std::random_device{}() };
+      std::uniform_real_distribution<double> real_dist{ -1000.0, 1000.0 };
+      std::uniform_int_distribution<long> int_dist{ std::numeric_limits<long>::min(), std::numeric_limits<long>::max() };
+
+      std::vector<Meter<double>> reals{};
+      std::vector<Meter<long>> integers{};
+      reals.reserve( N );
+      integers.reserve( N );
+
+      for( std::size_t i=0U; i<N; ++i ) {
+         reals.emplace_back( real_dist(rng) );
+         integers.emplace_back( int_dist(rng) );
+      }
+
+      benchmark( reals, "double" );
+      benchmark( integers, "long" );
+   }
+
+   std::cout << "\n";
+
+   return EXIT_SUCCESS;
+}
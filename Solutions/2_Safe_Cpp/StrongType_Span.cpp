@@ -0,0 +1,548 @@
+/**************************************************************************************************
+*
+* \file StrongType_Span.cpp
+* \brief C++ Training - Programming example about bulk operations on spans of strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Provide element-wise and reduction kernels (add, subtract, scale, axpy, sum, min/max)
+*       for spans of strong types. The kernels are only available if the strong type provides
+*       the according skill. Since the kernels directly operate on the underlying values, they
+*       compile to the same (vectorized) code as the corresponding loops on raw values. Spans of
+*       different sizes are detected (also in release builds), and kernels that write values are
+*       not available for strong types that check their values (e.g. 'Positive').
+*
+* Step 1: Compare the runtime of the strong type kernels and the raw 'double' kernels (for
+*         instance with '-O3 -march=native').
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Scalable.h> -------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Scalable
+{
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived& operator*=( Derived& lhs, U const& factor )
+      noexcept( noexcept( lhs.get() *= factor ) )
+   {
+      lhs.get() *= factor;
+      return lhs;
+   }
+
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived operator*( Derived const& lhs, U const& factor )
+      noexcept( noexcept( lhs.get() * factor ) )
+   {
+      return Derived{ lhs.get() * factor };
+   }
+
+   template< typename U, typename D = Derived >
+      requires std::same_as<U,typename D::value_type>
+   friend constexpr Derived operator*( U const& factor, Derived const& rhs )
+      noexcept( noexcept( factor * rhs.get() ) )
+   {
+      return Derived{ factor * rhs.get() };
+   }
+};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      os << d.get();
+      return os;
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <Comparable.h> -----------------------------------------------------------------------------
+
+template< typename Derived >
+struct Comparable
+   : public EqualityComparable<Derived>
+{
+   friend constexpr auto operator<=>( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() <=> rhs.get();
+   }
+};
+
+
+//---- <Positive.h> -------------------------------------------------------------------------------
+
+#include <stdexcept>
+
+template< typename Derived >
+struct Positive
+{
+   template< typename T >
+   constexpr void checkValue( T const& value ) const {
+      if( value < T{} ) {
+         throw std::invalid_argument( "Negative value detected" );
+      }
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <HasSkill.h> -------------------------------------------------------------------------------
+
+// Checks whether the strong type 'S' provides the given skill (directly or via a compound skill)
+template< typename S, template<typename...> class Skill >
+concept HasSkill = std::derived_from< S, Skill<S> >;
+
+// Checks whether the strong type 'S' doesn't check its values (see e.g. 'Positive'), i.e. whether
+// its underlying values can be written without a check
+template< typename S >
+concept Unchecked = !requires( S const& s, typename S::value_type const& v ) { s.checkValue( v ); };
+
+
+//---- <SpanKernels.h> ----------------------------------------------------------------------------
+
+//#include <HasSkill.h>
+//#include <StrongType.h>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+// All kernels operate directly on the underlying values (via 'get()') instead of creating
+// temporary strong types. Thus the loops are identical to the according loops on raw values
+// and can be vectorized in the same way. Since writing the underlying values bypasses the
+// 'checkValue()' function of a strong type, the writing kernels require 'Unchecked' types. The
+// sizes of the spans are checked once before the loop (i.e. not only in debug builds).
+
+namespace detail {
+
+constexpr void checkSizes( std::size_t lhs, std::size_t rhs )
+{
+   if( lhs != rhs ) {
+      throw std::invalid_argument( "Spans of different sizes detected" );
+   }
+}
+
+constexpr void checkNonEmpty( std::size_t size )
+{
+   if( size == 0U ) {
+      throw std::invalid_argument( "Empty span detected" );
+   }
+}
+
+} // namespace detail
+
+template< typename S >
+   requires ( HasSkill<S,Addable> && Unchecked<S> )
+constexpr void add( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result )
+{
+   detail::checkSizes( lhs.size(), result.size() );
+   detail::checkSizes( rhs.size(), result.size() );
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      result[i].get() = lhs[i].get() + rhs[i].get();
+   }
+}
+
+template< typename S >
+   requires ( HasSkill<S,Subtractable> && Unchecked<S> )
+constexpr void subtract( std::span<S const> lhs, std::span<S const> rhs, std::span<S> result )
+{
+   detail::checkSizes( lhs.size(), result.size() );
+   detail::checkSizes( rhs.size(), result.size() );
+
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      result[i].get() = lhs[i].get() - rhs[i].get();
+   }
+}
+
+// values[i] *= factor
+template< typename S >
+   requires ( HasSkill<S,Scalable> && Unchecked<S> )
+constexpr void scale( std::span<S> values, typename S::value_type const& factor )
+{
+   for( auto& value : values ) {
+      value.get() *= factor;
+   }
+}
+
+// y[i] += a * x[i]
+template< typename S >
+   requires ( HasSkill<S,Addable> && HasSkill<S,Scalable> && Unchecked<S> )
+constexpr void axpy( typename S::value_type const& a, std::span<S const> x, std::span<S> y )
+{
+   detail::checkSizes( x.size(), y.size() );
+
+   for( std::size_t i=0U; i<y.size(); ++i ) {
+      y[i].get() += a * x[i].get();
+   }
+}
+
+// Sum of all values. The four independent partial sums break the dependency chain of the
+// additions, which allows vectorization even for floating point values (without '-ffast-math').
+template< typename S >
+   requires HasSkill<S,Addable>
+constexpr S sum( std::span<S const> values )
+{
+   using T = typename S::value_type;
+
+   T partial[4]{};
+   std::size_t const n4{ values.size() - values.size()%4U };
+   std::size_t i{ 0U };
+
+   for( ; i<n4; i+=4U ) {
+      partial[0] += values[i   ].get();
+      partial[1] += values[i+1U].get();
+      partial[2] += values[i+2U].get();
+      partial[3] += values[i+3U].get();
+   }
+   for( ; i<values.size(); ++i ) {
+      partial[0] += values[i].get();
+   }
+
+   return S{ ( partial[0] + partial[1] ) + ( partial[2] + partial[3] ) };
+}
+
+template< typename S >
+   requires HasSkill<S,Comparable>
+constexpr S min( std::span<S const> values )
+{
+   detail::checkNonEmpty( values.size() );
+
+   auto result = values[0].get();
+   for( auto const& value : values.subspan(1U) ) {
+      result = value.get() < result ? value.get() : result;
+   }
+
+   return S{ result };
+}
+
+template< typename S >
+   requires HasSkill<S,Comparable>
+constexpr S max( std::span<S const> values )
+{
+   detail::checkNonEmpty( values.size() );
+
+   auto result = values[0].get();
+   for( auto const& value : values.subspan(1U) ) {
+      result = value.get() > result ? value.get() : result;
+   }
+
+   return S{ result };
+}
+
+
+//---- <RawKernels.h> -----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <span>
+
+// Reference kernels on raw values for the runtime comparison
+namespace raw {
+
+void add( std::span<double const> lhs, std::span<double const> rhs, std::span<double> result )
+{
+   for( std::size_t i=0U; i<result.size(); ++i ) {
+      result[i] = lhs[i] + rhs[i];
+   }
+}
+
+void axpy( double a, std::span<double const> x, std::span<double> y )
+{
+   for( std::size_t i=0U; i<y.size(); ++i ) {
+      y[i] += a * x[i];
+   }
+}
+
+double sum( std::span<double const> values )
+{
+   double partial[4]{};
+   std::size_t const n4{ values.size() - values.size()%4U };
+   std::size_t i{ 0U };
+
+   for( ; i<n4; i+=4U ) {
+      partial[0] += values[i   ];
+      partial[1] += values[i+1U];
+      partial[2] += values[i+2U];
+      partial[3] += values[i+3U];
+   }
+   for( ; i<values.size(); ++i ) {
+      partial[0] += values[i];
+   }
+
+   return ( partial[0] + partial[1] ) + ( partial[2] + partial[3] );
+}
+
+double max( std::span<double const> values )
+{
+   auto result = values[0];
+   for( auto const value : values.subspan(1U) ) {
+      result = value > result ? value : result;
+   }
+   return result;
+}
+
+} // namespace raw
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+template< typename T >
+using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Scalable,Comparable,Printable>;
+
+
+//---- <Kilometer.h> ------------------------------------------------------------------------------
+
+template< typename T >
+using Kilometer = StrongType<T,struct KilometerTag,IntegralArithmetic,Printable,EqualityComparable>;
+
+
+//---- <Distance.h> -------------------------------------------------------------------------------
+
+template< typename T >
+using Distance = StrongType<T,struct DistanceTag,IntegralArithmetic,Scalable,Comparable,Printable,Positive>;
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+template< typename S >
+concept SupportsScale = requires( std::span<S> s, typename S::value_type factor ){ scale( s, factor ); };
+
+template< typename S >
+concept SupportsMax = requires( std::span<S const> s ){ max( s ); };
+
+template< typename S >
+concept SupportsSubtract = requires( std::span<S const> s, std::span<S> r ){ subtract( s, s, r ); };
+
+int main()
+{
+   static_assert( sizeof(Meter<double>) == sizeof(double) );
+
+   // The kernels are only available for strong types with the according skills
+   static_assert(  SupportsScale<Meter<double>> );
+   static_assert( !SupportsScale<Kilometer<double>> );
+   static_assert(  SupportsMax<Meter<double>> );
+   static_assert( !SupportsMax<Kilometer<double>> );
+
+   // Writing kernels would bypass the check of 'Positive' (e.g. 'subtract()' could result in
+   // negative distances), reading kernels construct checked values
+   static_assert(  SupportsSubtract<Meter<double>> );
+   static_assert( !SupportsSubtract<Distance<double>> );
+   static_assert( !SupportsScale<Distance<double>> );
+   static_assert(  SupportsMax<Distance<double>> );
+
+   {
+      std::vector<Meter<double>> const a{ Meter<double>{1.0}, Meter<double>{2.0}, Meter<double>{3.0} };
+      std::vector<Meter<double>> b{ Meter<double>{10.0}, Meter<double>{20.0}, Meter<double>{30.0} };
+
+      axpy( 2.0, std::span<Meter<double> const>{ a }, std::span{ b } );
+
+      std::span<Meter<double> const> const values{ b };
+      std::cout << "\n sum = " << sum( values ) << "m"
+                << "\n min = " << min( values ) << "m"
+                << "\n max = " << max( values ) << "m\n";
+
+      // A result span of a different size is detected before any value is written
+      std::vector<Meter<double>> c( 2U );
+      try {
+         add( std::span<Meter<double> const>{ a }, values, std::span{ c } );
+         std::cerr << "\n ERROR: add() accepted spans of different sizes\n";
+         return EXIT_FAILURE;
+      }
+      catch( std::invalid_argument const& ex ) {
+         std::cout << " add(): " << ex.what() << "\n";
+      }
+   }
+
+   {
+      constexpr std::size_t N = 10000000U;
+      constexpr std::size_t repetitions = 10U;
+
+      std::random_device rd{};
+      std::mt19937 mt{ rd() };
+      std::uniform_real_distribution<double> dist{ 0.0, 100.0 };
+
+      std::vector<double> raw_x( N ), raw_y( N ), raw_z( N );
+      std::ranges::generate( raw_x, [&]{ return dist(mt); } );
+      std::ranges::generate( raw_y, [&]{ return dist(mt); } );
+
+      std::vector<Meter<double>> x( N ), y( N ), z( N );
+      std::ranges::transform( raw_x, begin(x), []( double d ){ return Meter<double>{d}; } );
+      std::ranges::transform( raw_y, begin(y), []( double d ){ return Meter<double>{d}; } );
+
+      double raw_result{};
+      Meter<double> strong_result{};
+
+      double const seconds_raw = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) {
+            raw::add( raw_x, raw_y, raw_z );
+            raw::axpy( 0.5, raw_x, raw_z );
+            raw_result += raw::sum( raw_z ) + raw::max( raw_z );
+         }
+      } );
+
+      double const seconds_strong = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) {
+            std::span<Meter<double> const> const cx{ x }, cy{ y }, cz{ z };
+            add( cx, cy, std::span{ z } );
+            axpy( 0.5, cx, std::span{ z } );
+            strong_result += sum( cz ) + max( cz );
+         }
+      } );
+
+      std::cout << "\n Runtime of add+axpy+sum+max on " << N << " values:"
+                << "\n  double        : " << seconds_raw / repetitions * 1E3 << "ms (result=" << raw_result << ")"
+                << "\n  Meter<double> : " << seconds_strong / repetitions * 1E3 << "ms (result=" << strong_result << ")\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
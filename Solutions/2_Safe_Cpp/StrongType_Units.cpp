@@ -0,0 +1,461 @@
+/**************************************************************************************************
+*
+* \file StrongType_Units.cpp
+* \brief C++ Training - Programming example about compile time unit conversions of strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: 'Meter' and 'Kilometer' are not unrelated types, but different units of the same
+*       dimension (length). By encoding the dimension and the scale factor (as 'std::ratio') in
+*       the tag of the 'StrongType', conversions ('quantity_cast()') and mixed-unit arithmetic
+*       can be generated at compile time. A conversion folds to a single multiplication or to
+*       nothing at all (see 'Codegen/StrongType_Units.cpp').
+*
+* Step 1: Compare the assembly output of the two 'to_meter()' functions (for instance by means
+*         of Compiler Explorer; godbolt.org). Is there any overhead for the unit conversion?
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      os << d.get();
+      return os;
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <Unit.h> -----------------------------------------------------------------------------------
+
+//#include <StrongType.h>
+#include <numeric>
+#include <ratio>
+
+// Tag for strong types representing a physical quantity: all units of the same dimension share
+// the 'Dimension' tag and differ only in the scale factor relative to the base unit.
+template< typename Dimension, typename Ratio >
+struct UnitTag
+{};
+
+template< typename S >
+struct QuantityTraits
+{};
+
+template< typename T, typename Dimension, typename Ratio, template<typename...> class... Skills >
+struct QuantityTraits< StrongType<T,UnitTag<Dimension,Ratio>,Skills...> >
+{
+   using value_type = T;
+   using dimension = Dimension;
+   using ratio = typename Ratio::type;
+
+   template< typename U, typename R >
+   using rebind = StrongType<U,UnitTag<Dimension,R>,Skills...>;
+};
+
+template< typename S >
+concept Quantity = requires { typename QuantityTraits<S>::dimension; };
+
+template< typename S1, typename S2 >
+concept SameDimension =
+   Quantity<S1> && Quantity<S2> &&
+   std::same_as< typename QuantityTraits<S1>::dimension, typename QuantityTraits<S2>::dimension >;
+
+// The common unit of two units is the largest unit that both units are an integral multiple of
+// (analogous to 'std::chrono::duration'), e.g. 'Meter' for 'Meter' and 'Kilometer'.
+template< typename R1, typename R2 >
+using CommonRatio = std::ratio< std::gcd( R1::num, R2::num ), std::lcm( R1::den, R2::den ) >;
+
+template< typename S1, typename S2 >
+   requires SameDimension<S1,S2>
+using CommonQuantity = typename QuantityTraits<S1>::template rebind<
+   std::common_type_t< typename S1::value_type, typename S2::value_type >,
+   CommonRatio< typename QuantityTraits<S1>::ratio, typename QuantityTraits<S2>::ratio > >;
+
+
+//---- <QuantityCast.h> ---------------------------------------------------------------------------
+
+//#include <Unit.h>
+
+// Conversion between two units of the same dimension. The conversion factor is computed at
+// compile time, i.e. the conversion results in a single multiplication (or division for an
+// integral downscaling) or in no operation at all.
+template< Quantity To, Quantity From >
+   requires SameDimension<To,From>
+constexpr To quantity_cast( From const& from )
+{
+   using Factor = std::ratio_divide< typename QuantityTraits<From>::ratio
+                                   , typename QuantityTraits<To>::ratio >;
+   using T = typename To::value_type;
+   using C = std::common_type_t< T, typename From::value_type, std::intmax_t >;
+
+   if constexpr( Factor::num == 1 && Factor::den == 1 ) {
+      return To{ static_cast<T>( from.get() ) };
+   }
+   else if constexpr( Factor::den == 1 ) {
+      return To{ static_cast<T>( static_cast<C>( from.get() ) * static_cast<C>( Factor::num ) ) };
+   }
+   else if constexpr( std::floating_point<C> ) {
+      constexpr C factor{ static_cast<C>( Factor::num ) / static_cast<C>( Factor::den ) };
+      return To{ static_cast<T>( static_cast<C>( from.get() ) * factor ) };
+   }
+   else if constexpr( Factor::num == 1 ) {
+      return To{ static_cast<T>( static_cast<C>( from.get() ) / static_cast<C>( Factor::den ) ) };
+   }
+   else {
+      return To{ static_cast<T>( static_cast<C>( from.get() ) * static_cast<C>( Factor::num )
+                                                             / static_cast<C>( Factor::den ) ) };
+   }
+}
+
+
+//---- <UnitArithmetic.h> -------------------------------------------------------------------------
+
+//#include <QuantityCast.h>
+#include <compare>
+
+// Arithmetic and comparison operations between different units of the same dimension. The
+// result is expressed in the common unit of both operands.
+template< typename Derived >
+struct UnitArithmetic
+{
+   template< typename Other >
+      requires ( SameDimension<Derived,Other> && !std::same_as<Derived,Other> )
+   friend constexpr auto operator+( Derived const& lhs, Other const& rhs )
+   {
+      using R = CommonQuantity<Derived,Other>;
+      return R{ quantity_cast<R>( lhs ).get() + quantity_cast<R>( rhs ).get() };
+   }
+
+   template< typename Other >
+      requires ( SameDimension<Derived,Other> && !std::same_as<Derived,Other> )
+   friend constexpr auto operator-( Derived const& lhs, Other const& rhs )
+   {
+      using R = CommonQuantity<Derived,Other>;
+      return R{ quantity_cast<R>( lhs ).get() - quantity_cast<R>( rhs ).get() };
+   }
+
+   template< typename Other >
+      requires ( SameDimension<Derived,Other> && !std::same_as<Derived,Other> )
+   friend constexpr bool operator==( Derived const& lhs, Other const& rhs )
+   {
+      using R = CommonQuantity<Derived,Other>;
+      return quantity_cast<R>( lhs ).get() == quantity_cast<R>( rhs ).get();
+   }
+
+   template< typename Other >
+      requires ( SameDimension<Derived,Other> && !std::same_as<Derived,Other> )
+   friend constexpr auto operator<=>( Derived const& lhs, Other const& rhs )
+   {
+      using R = CommonQuantity<Derived,Other>;
+      return quantity_cast<R>( lhs ).get() <=> quantity_cast<R>( rhs ).get();
+   }
+};
+
+
+//---- <Length.h> ---------------------------------------------------------------------------------
+
+//#include <Unit.h>
+//#include <UnitArithmetic.h>
+
+template< typename T, typename Ratio >
+using Length = StrongType<T,UnitTag<struct LengthTag,Ratio>,IntegralArithmetic,Printable,EqualityComparable,UnitArithmetic>;
+
+
+//---- <IntegerLiteral.h> ------------------------------------------------------------------------
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace detail {
+
+// Parses the digits of an integer literal (decimal, hexadecimal, binary or octal, with optional
+// digit separators) at compile time. Values exceeding 'unsigned long long' are rejected.
+template< char... Chars >
+consteval unsigned long long parse_integer_literal()
+{
+   constexpr char chars[]{ Chars... };
+   constexpr std::size_t size{ sizeof...(Chars) };
+
+   unsigned long long base{ 10U };
+   std::size_t i{ 0U };
+
+   if( size > 1U && chars[0] == '0' ) {
+      if( chars[1] == 'x' || chars[1] == 'X' )      { base = 16U; i = 2U; }
+      else if( chars[1] == 'b' || chars[1] == 'B' ) { base =  2U; i = 2U; }
+      else                                          { base =  8U; i = 1U; }
+   }
+
+   unsigned long long value{ 0U };
+
+   for( ; i<size; ++i )
+   {
+      char const c{ chars[i] };
+      if( c == '\'' ) continue;
+
+      unsigned long long const digit =
+         ( c >= '0' && c <= '9' ) ? static_cast<unsigned long long>( c - '0' ) :
+         ( c >= 'a' && c <= 'f' ) ? static_cast<unsigned long long>( c - 'a' + 10 ) :
+         ( c >= 'A' && c <= 'F' ) ? static_cast<unsigned long long>( c - 'A' + 10 ) : base;
+
+      if( digit >= base ) {
+         throw std::invalid_argument( "Invalid digit in integer literal" );
+      }
+      if( value > ( std::numeric_limits<unsigned long long>::max() - digit ) / base ) {
+         throw std::out_of_range( "Integer literal out of range" );
+      }
+
+      value = value*base + digit;
+   }
+
+   return value;
+}
+
+// The narrowest type that can represent the given value exactly (same as for integer literals
+// without suffix)
+template< unsigned long long Value >
+using narrowest_integer_t =
+   std::conditional_t< Value <= static_cast<unsigned long long>( std::numeric_limits<int>::max() ), int,
+   std::conditional_t< Value <= static_cast<unsigned long long>( std::numeric_limits<long>::max() ), long,
+                       long long > >;
+
+template< unsigned long long Value >
+constexpr bool fits_integer_v =
+   Value <= static_cast<unsigned long long>( std::numeric_limits<long long>::max() );
+
+} // namespace detail
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+//#include <IntegerLiteral.h>
+//#include <Length.h>
+
+template< typename T >
+using Meter = Length<T,std::ratio<1>>;
+
+// The digits are parsed at compile time: the literal results in the narrowest type that can
+// represent the value exactly and literals exceeding 'long long' do not compile
+template< char... Chars >
+[[nodiscard]] consteval auto operator""_m()
+{
+   constexpr unsigned long long m{ detail::parse_integer_literal<Chars...>() };
+   static_assert( detail::fits_integer_v<m>, "Meter literal out of range" );
+
+   using T = detail::narrowest_integer_t<m>;
+   return Meter<T>{ static_cast<T>(m) };
+}
+
+[[nodiscard]] consteval Meter<long double> operator""_m( long double m ) noexcept
+{
+   return Meter<long double>{ m };
+}
+
+
+//---- <Kilometer.h> ------------------------------------------------------------------------------
+
+//#include <IntegerLiteral.h>
+//#include <Length.h>
+
+template< typename T >
+using Kilometer = Length<T,std::kilo>;
+
+template< char... Chars >
+[[nodiscard]] consteval auto operator""_km()
+{
+   constexpr unsigned long long km{ detail::parse_integer_literal<Chars...>() };
+   static_assert( detail::fits_integer_v<km>, "Kilometer literal out of range" );
+
+   using T = detail::narrowest_integer_t<km>;
+   return Kilometer<T>{ static_cast<T>(km) };
+}
+
+[[nodiscard]] consteval Kilometer<long double> operator""_km( long double km ) noexcept
+{
+   return Kilometer<long double>{ km };
+}
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+double to_meter( double kilometer )
+{
+   return kilometer * 1000.0;
+}
+
+Meter<double> to_meter( Kilometer<double> kilometer )
+{
+   return quantity_cast<Meter<double>>( kilometer );
+}
+
+int main()
+{
+   // Conversions
+   static_assert( quantity_cast<Meter<long>>( 3_km ) == 3000_m );
+   static_assert( quantity_cast<Kilometer<long>>( 4500_m ) == Kilometer<long>{ 4 } );
+   static_assert( quantity_cast<Kilometer<double>>( Meter<double>{ 4500.0 } ) == Kilometer<double>{ 4.5 } );
+
+   // Mixed-unit arithmetic (expressed in the common unit 'Meter')
+   static_assert( std::same_as< decltype( 1_km + 200_m ), Meter<int> > );
+   static_assert( 1_km + 200_m == 1200_m );
+   static_assert( 2_km - 500_m == 1500_m );
+   static_assert( 1_km == 1000_m );
+   static_assert( 999_m < 1_km );
+
+   // Literals result in the narrowest type that represents the value exactly (instead of wrapping)
+   static_assert( std::same_as< decltype(3'000'000'000_m), Meter<long> > );
+   static_assert( 3'000'000'000_m == 3'000'000_km );
+   //auto const too_large = 18'446'744'073'709'551'615_m;  // Does not compile (exceeds 'long long')
+
+   // Different dimensions cannot be mixed
+   using Second = StrongType<long,UnitTag<struct TimeTag,std::ratio<1>>,IntegralArithmetic,UnitArithmetic>;
+   static_assert( !SameDimension<Meter<long>,Second> );
+
+   {
+      auto const distance = 42_km + 195_m;
+
+      std::cout << "\n Marathon distance = " << distance << "m"
+                << "\n                   = " << quantity_cast<Kilometer<double>>( distance ) << "km\n";
+
+      std::cout << "\n to_meter( 1.5 ) = " << to_meter( 1.5 )
+                << "\n to_meter( Kilometer<double>{1.5} ) = " << to_meter( Kilometer<double>{1.5} ) << "m\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,358 @@
+/**************************************************************************************************
+*
+* \file StrongType_View.cpp
+* \brief C++ Training - Programming example about zero-copy views between raw values and strong types
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Avoid copying buffers of raw values (e.g. from sensors, memory mapped files or network
+*       buffers) element by element into strong types. A 'StrongType' with a standard layout and
+*       the same size and alignment as its underlying type can be viewed in place:
+*        - 'as_strong<S>()' presents a 'std::span<T>' (or a span of bytes) as 'std::span<S>'
+*        - 'as_underlying()' presents a 'std::span<S>' as 'std::span<T>'
+*       Both views start the lifetime of the new objects in the existing storage, i.e. after
+*       creating a view the storage should only be accessed via this view. Views of modifiable
+*       storage create the objects by means of 'std::memmove()' (C++20). Views of const storage
+*       (which may be read-only) require 'std::start_lifetime_as_array()' (C++23) and are not
+*       available before.
+*
+**************************************************************************************************/
+
+#include <cstdlib>
+#include <algorithm>
+#include <concepts>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+
+//---- <Addable.h> --------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Addable
+{
+   friend constexpr Derived& operator+=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() += rhs.get() ) )
+   {
+      lhs.get() += rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator+( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() + rhs.get() ) )
+   {
+      return Derived{ lhs.get() + rhs.get() };
+   }
+};
+
+
+//---- <Subtractable.h> ---------------------------------------------------------------------------
+
+template< typename Derived >
+struct Subtractable
+{
+   friend constexpr Derived& operator-=( Derived& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() -= rhs.get() ) )
+   {
+      lhs.get() -= rhs.get();
+      return lhs;
+   }
+
+   friend constexpr Derived operator-( Derived const& lhs, Derived const& rhs )
+      noexcept( noexcept( lhs.get() - rhs.get() ) )
+   {
+      return Derived{ lhs.get() - rhs.get() };
+   }
+};
+
+
+//---- <IntegralArithmetic.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct IntegralArithmetic
+   : public Addable<Derived>
+   , public Subtractable<Derived>
+{};
+
+
+//---- <Printable.h> ------------------------------------------------------------------------------
+
+template< typename Derived >
+struct Printable
+{
+   friend std::ostream& operator<<( std::ostream& os, Derived const& d )
+   {
+      os << d.get();
+      return os;
+   }
+};
+
+
+//---- <EqualityComparable.h> ---------------------------------------------------------------------
+
+template< typename Derived >
+struct EqualityComparable
+{
+   friend constexpr bool operator==( Derived const& lhs, Derived const& rhs )
+   {
+      return lhs.get() == rhs.get();
+   }
+};
+
+
+//---- <StrongType.h> -----------------------------------------------------------------------------
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+class StrongType final
+   : public Skills< StrongType<T,Tag,Skills...> >...
+{
+ public:
+   using value_type = T;
+
+   constexpr StrongType() = default;
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   explicit constexpr StrongType( U&& value ) : value_( std::forward<U>(value) )
+   {
+      if constexpr( requires { this->checkValue(value_); } ) {
+         this->checkValue(value_);
+      }
+   }
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...> const& value )
+      : value_{ value.get() }
+   {}
+
+   template< typename U >
+      requires std::constructible_from<T,U>
+   constexpr explicit StrongType( StrongType<U,Tag,Skills...>&& value )
+      : value_{ std::move(value).get() }
+   {}
+
+   StrongType( StrongType const& ) = default;
+   StrongType( StrongType&& ) = default;
+   ~StrongType() = default;
+   StrongType& operator=( StrongType const& ) & = default;
+   StrongType& operator=( StrongType&& ) & = default;
+
+   [[nodiscard]] constexpr T&        get()       &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&  get() const &  noexcept { return value_; }
+   [[nodiscard]] constexpr T const&& get()       && noexcept { return std::move(value_); }
+   [[nodiscard]] constexpr T&&       get() const && noexcept { return std::move(value_); }
+
+   constexpr void swap( StrongType& other ) noexcept( std::is_nothrow_swappable_v<T> )
+   {
+      std::ranges::swap( value_, other.value_ );
+   }
+
+ private:
+   T value_{};
+};
+
+template< typename T, typename Tag, template<typename...> class... Skills >
+constexpr void swap( StrongType<T,Tag,Skills...>& a, StrongType<T,Tag,Skills...>& b )
+   noexcept( std::is_nothrow_swappable_v<T> )
+{
+   a.swap( b );
+}
+
+
+//---- <LayoutCompatible.h> -----------------------------------------------------------------------
+
+//#include <StrongType.h>
+#include <type_traits>
+
+// A strong type is layout compatible with its underlying type if it is a standard layout type
+// (i.e. its only data member is located at offset 0), it has the same size and alignment (i.e.
+// all skills are empty bases) and it is trivially copyable and destructible (i.e. it is an
+// implicit-lifetime type, whose lifetime can be started in existing storage).
+// Note: MSVC requires '__declspec(empty_bases)' to apply the empty base optimization to more
+// than one skill.
+template< typename S >
+concept LayoutCompatible =
+   std::is_standard_layout_v<S> &&
+   std::is_trivially_copyable_v<S> &&
+   std::is_trivially_destructible_v<S> &&
+   std::is_standard_layout_v<typename S::value_type> &&
+   std::is_trivially_copyable_v<typename S::value_type> &&
+   sizeof(S) == sizeof(typename S::value_type) &&
+   alignof(S) == alignof(typename S::value_type);
+
+
+//---- <StrongView.h> -----------------------------------------------------------------------------
+
+//#include <LayoutCompatible.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+
+namespace detail {
+
+// Starts the lifetime of an array of 'n' objects of type 'To' in the given storage, without
+// changing the object representation.
+template< typename To >
+To* start_lifetime_as_array( void* p, std::size_t n ) noexcept
+{
+#if defined(__cpp_lib_start_lifetime_as) && __cpp_lib_start_lifetime_as >= 202207L
+   return std::start_lifetime_as_array<To>( p, n );
+#else
+   // 'std::memmove()' implicitly creates objects of implicit-lifetime types in the destination
+   // storage (P0593). Compilers remove the self-move completely.
+   std::memmove( p, p, n*sizeof(To) );
+   return std::launder( static_cast<To*>( p ) );
+#endif
+}
+
+#if defined(__cpp_lib_start_lifetime_as) && __cpp_lib_start_lifetime_as >= 202207L
+// There is no way to implicitly create objects in (potentially read-only) storage before C++23
+#  define STRONG_VIEW_CONST_STORAGE 1
+
+template< typename To >
+To const* start_lifetime_as_array( void const* p, std::size_t n ) noexcept
+{
+   return std::start_lifetime_as_array<To>( p, n );
+}
+#endif
+
+// Returns the number of elements of type 'S' in the given byte buffer
+template< typename S >
+std::size_t elements( std::byte const* data, std::size_t size )
+{
+   if( reinterpret_cast<std::uintptr_t>( data ) % alignof(S) != 0U ) {
+      throw std::invalid_argument( "Misaligned buffer detected" );
+   }
+   if( size % sizeof(S) != 0U ) {
+      throw std::invalid_argument( "Incomplete element detected" );
+   }
+   return size / sizeof(S);
+}
+
+} // namespace detail
+
+
+// std::span<T> -> std::span<S>
+template< LayoutCompatible S >
+std::span<S> as_strong( std::span<typename S::value_type> values ) noexcept
+{
+   return { detail::start_lifetime_as_array<S>( values.data(), values.size() ), values.size() };
+}
+
+// std::span<std::byte> -> std::span<S> (e.g. for memory mapped files or network buffers)
+template< LayoutCompatible S >
+std::span<S> as_strong( std::span<std::byte> bytes )
+{
+   std::size_t const n{ detail::elements<S>( bytes.data(), bytes.size() ) };
+   return { detail::start_lifetime_as_array<S>( bytes.data(), n ), n };
+}
+
+#ifdef STRONG_VIEW_CONST_STORAGE
+template< LayoutCompatible S >
+std::span<S const> as_strong( std::span<typename S::value_type const> values ) noexcept
+{
+   return { detail::start_lifetime_as_array<S>( values.data(), values.size() ), values.size() };
+}
+
+template< LayoutCompatible S >
+std::span<S const> as_strong( std::span<std::byte const> bytes )
+{
+   std::size_t const n{ detail::elements<S>( bytes.data(), bytes.size() ) };
+   return { detail::start_lifetime_as_array<S>( bytes.data(), n ), n };
+}
+#endif
+
+// std::span<S> -> std::span<T>
+template< LayoutCompatible S >
+std::span<typename S::value_type> as_underlying( std::span<S> values ) noexcept
+{
+   using T = typename S::value_type;
+   return { detail::start_lifetime_as_array<T>( values.data(), values.size() ), values.size() };
+}
+
+#ifdef STRONG_VIEW_CONST_STORAGE
+template< LayoutCompatible S >
+std::span<typename S::value_type const> as_underlying( std::span<S const> values ) noexcept
+{
+   using T = typename S::value_type;
+   return { detail::start_lifetime_as_array<T>( values.data(), values.size() ), values.size() };
+}
+#endif
+
+
+//---- <Meter.h> ----------------------------------------------------------------------------------
+
+template< typename T >
+using Meter = StrongType<T,struct MeterTag,IntegralArithmetic,Printable,EqualityComparable>;
+
+static_assert( LayoutCompatible< Meter<double> > );
+static_assert( LayoutCompatible< Meter<long> > );
+
+
+//---- <Kilometer.h> ------------------------------------------------------------------------------
+
+template< typename T >
+using Kilometer = StrongType<T,struct KilometerTag,IntegralArithmetic,Printable,EqualityComparable>;
+
+static_assert( LayoutCompatible< Kilometer<double> > );
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+template< typename S, typename Span >
+concept Viewable = requires( Span values ){ as_strong<S>( values ); };
+
+int main()
+{
+   // Strong types with non-trivial underlying types cannot be viewed in place
+   static_assert( !LayoutCompatible< StrongType<std::string,struct NameTag> > );
+
+   // Const (potentially read-only) storage can only be viewed with 'std::start_lifetime_as_array()'
+   static_assert( Viewable< Meter<double>, std::span<double> > );
+#ifdef STRONG_VIEW_CONST_STORAGE
+   static_assert( Viewable< Meter<double>, std::span<double const> > );
+#else
+   static_assert( !Viewable< Meter<double>, std::span<double const> > );
+#endif
+
+   // Zero-copy ingestion of raw sensor values
+   {
+      std::vector<double> sensor{ 1.5, 2.5, 3.0, 4.0 };
+
+      std::span<Meter<double>> const meters{ as_strong<Meter<double>>( std::span{ sensor } ) };
+
+      meters[0] += Meter<double>{ 0.5 };
+      auto const total = std::accumulate( begin(meters), end(meters), Meter<double>{} );
+
+      std::cout << "\n total = " << total << "m\n";
+
+      // ... and back to raw values
+      std::span<double> const raw{ as_underlying( meters ) };
+      std::cout << " raw[0] = " << raw[0] << "\n";
+   }
+
+   // Zero-copy ingestion from a byte buffer (e.g. a network buffer)
+   {
+      alignas(double) std::byte buffer[3U*sizeof(double)]{};
+      double const values[3]{ 10.0, 20.0, 30.0 };
+      std::memcpy( buffer, values, sizeof(values) );
+
+      std::span<Meter<double> const> const meters{ as_strong<Meter<double>>( std::span{ buffer } ) };
+
+      std::cout << " meters[2] = " << meters[2] << "m\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,590 @@
+/**************************************************************************************************
+*
+* \file Visitor_Aggregates.cpp
+* \brief C++ Training - Programming example for incrementally maintained aggregates of shapes
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Query the total area, the number of shapes per type and the bounds of a scene after
+*       every small edit. Instead of a full pass over all shapes per query, the 'AggregatedShapes'
+*       class keeps these aggregates up to date on every insert, erase and modify operation:
+*        - the total area and the counts per type are updated in O(1) (the total area is
+*          periodically recomputed to limit the accumulation of rounding errors)
+*        - the bounds are kept in a min/max tree, which is lazily repaired on query in O(k log n)
+*          (with 'k' the number of edits since the last query, at most O(n))
+*
+* Step 1: Compare the runtime of the full pass and the incremental aggregates.
+*
+**************************************************************************************************/
+
+
+//---- <Point.h> ----------------------------------------------------------------------------------
+
+struct Point
+{
+   double x;
+   double y;
+};
+
+
+//---- <Circle.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+class Circle
+{
+ public:
+   explicit Circle( double radius, Point center = {} )
+      : radius_{ radius }
+      , center_{ center }
+   {}
+
+   double radius() const { return radius_; }
+   Point  center() const { return center_; }
+
+ private:
+   double radius_;
+   Point center_;
+};
+
+
+//---- <Square.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+class Square
+{
+ public:
+   explicit Square( double side, Point center = {} )
+      : side_{ side }
+      , center_{ center }
+   {}
+
+   double side() const { return side_; }
+   Point center() const { return center_; }
+
+ private:
+   double side_;
+   Point center_;
+};
+
+
+//---- <Shape.h> ----------------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#include <variant>
+
+using Shape = std::variant<Circle,Square>;
+
+
+//---- <Shapes.h> ---------------------------------------------------------------------------------
+
+//#include <Shape.h>
+#include <vector>
+
+using Shapes = std::vector<Shape>;
+
+
+//==== ARCHITECTURAL BOUNDARY =====================================================================
+
+
+//---- <Area.h> -----------------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+class Area
+{
+ public:
+   double operator()( Circle const& circle ) const
+   {
+      return circle.radius() * circle.radius() * M_PI;
+   }
+
+   double operator()( Square const& square ) const
+   {
+      return square.side() * square.side();
+   }
+};
+
+
+//---- <BoundingBox.h> ----------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Point.h>
+//#include <Square.h>
+#include <algorithm>
+#include <limits>
+
+struct BoundingBox
+{
+   // The default bounding box is empty, i.e. the neutral element of 'merge()'
+   Point min{  std::numeric_limits<double>::infinity(),  std::numeric_limits<double>::infinity() };
+   Point max{ -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+
+   bool empty() const { return min.x > max.x; }
+};
+
+inline BoundingBox merge( BoundingBox const& lhs, BoundingBox const& rhs )
+{
+   return BoundingBox{ { std::min( lhs.min.x, rhs.min.x ), std::min( lhs.min.y, rhs.min.y ) }
+                     , { std::max( lhs.max.x, rhs.max.x ), std::max( lhs.max.y, rhs.max.y ) } };
+}
+
+class ComputeBoundingBox
+{
+ public:
+   BoundingBox operator()( Circle const& circle ) const
+   {
+      auto const [x,y] = circle.center();
+      auto const r = circle.radius();
+      return BoundingBox{ { x-r, y-r }, { x+r, y+r } };
+   }
+
+   BoundingBox operator()( Square const& square ) const
+   {
+      auto const [x,y] = square.center();
+      auto const h = square.side() / 2.0;
+      return BoundingBox{ { x-h, y-h }, { x+h, y+h } };
+   }
+};
+
+
+//---- <AggregatedShapes.h> -----------------------------------------------------------------------
+
+//#include <Area.h>
+//#include <BoundingBox.h>
+//#include <Shapes.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Index of the alternative 'T' in the variant type 'Variant'
+template< typename T, typename Variant >
+struct VariantIndex;
+
+template< typename T, typename... Ts >
+struct VariantIndex< T, std::variant<Ts...> >
+{
+   static constexpr std::size_t value = []{
+      constexpr bool matches[] = { std::is_same_v<T,Ts>... };
+      return static_cast<std::size_t>( std::ranges::find( matches, true ) - std::ranges::begin(matches) );
+   }();
+
+   static_assert( value < sizeof...(Ts), "T is not an alternative of the variant" );
+};
+
+// Wrapper around a 'Shapes' container, which keeps the total area, the number of shapes per type
+// and the bounds of all shapes up to date. Erasing a shape moves the last shape into the gap
+// (swap-and-pop), i.e. erasing invalidates the index of the last shape.
+class AggregatedShapes
+{
+ public:
+   AggregatedShapes() = default;
+   explicit AggregatedShapes( Shapes shapes );
+
+   std::size_t insert( Shape const& shape );
+   void erase( std::size_t index );
+   void modify( std::size_t index, Shape const& shape );
+
+   Shape const& operator[]( std::size_t index ) const { return shapes_[index]; }
+   Shapes const& shapes() const { return shapes_; }
+   std::size_t size() const { return shapes_.size(); }
+
+   double totalArea() const { return area_; }
+
+   template< typename T >
+   std::size_t count() const;
+
+   BoundingBox bounds() const;
+
+ private:
+   static constexpr std::size_t kinds = std::variant_size_v<Shape>;
+
+   // Minimum number of area updates between two recomputations of the total area
+   static constexpr std::size_t minUpdates = 1024U;
+
+   void add( Shape const& shape );
+   void remove( Shape const& shape );
+   void refreshArea();
+
+   void grow();
+   void setLeaf( std::size_t index, BoundingBox const& box );
+   void repair() const;
+   static void build( std::vector<BoundingBox>& tree, std::size_t capacity );
+
+   Shapes shapes_{};
+   double area_{};
+   std::size_t updates_{};  // Number of area updates since the last recomputation
+   std::array<std::size_t,kinds> counts_{};
+
+   // Min/max tree over the bounding boxes of all shapes: leaf 'i' is stored at 'tree_[capacity_+i]',
+   // the inner node 'i' is the merge of the nodes '2i' and '2i+1', and the root is 'tree_[1]'. Leaves
+   // are updated eagerly, inner nodes are repaired on the next 'bounds()' query. If more leaves
+   // than the capacity have been updated since the last query, the tree is rebuilt instead.
+   std::size_t capacity_{};
+   mutable std::vector<BoundingBox> tree_{};
+   mutable std::vector<std::size_t> dirty_{};
+   mutable bool rebuild_{ false };
+};
+
+
+//---- <AggregatedShapes.cpp> ---------------------------------------------------------------------
+
+//#include <AggregatedShapes.h>
+#include <bit>
+#include <utility>
+
+AggregatedShapes::AggregatedShapes( Shapes shapes )
+   : shapes_{ std::move(shapes) }
+   , capacity_{ std::bit_ceil( std::max<std::size_t>( shapes_.size(), 1U ) ) }
+   , tree_( 2U*capacity_ )
+{
+   for( std::size_t i=0U; i<shapes_.size(); ++i ) {
+      add( shapes_[i] );
+      tree_[capacity_+i] = std::visit( ComputeBoundingBox{}, shapes_[i] );
+   }
+
+   updates_ = 0U;
+   build( tree_, capacity_ );
+}
+
+std::size_t AggregatedShapes::insert( Shape const& shape )
+{
+   if( shapes_.size() == capacity_ ) {
+      grow();
+   }
+
+   std::size_t const index = shapes_.size();
+   shapes_.push_back( shape );
+   add( shape );
+   setLeaf( index, std::visit( ComputeBoundingBox{}, shape ) );
+   refreshArea();
+
+   return index;
+}
+
+void AggregatedShapes::erase( std::size_t index )
+{
+   std::size_t const last = shapes_.size() - 1U;
+
+   remove( shapes_[index] );
+
+   if( index != last ) {
+      shapes_[index] = std::move( shapes_[last] );
+      setLeaf( index, tree_[capacity_+last] );
+   }
+
+   shapes_.pop_back();
+   setLeaf( last, BoundingBox{} );
+   refreshArea();
+}
+
+void AggregatedShapes::modify( std::size_t index, Shape const& shape )
+{
+   remove( shapes_[index] );
+   shapes_[index] = shape;
+   add( shape );
+   setLeaf( index, std::visit( ComputeBoundingBox{}, shape ) );
+   refreshArea();
+}
+
+template< typename T >
+std::size_t AggregatedShapes::count() const
+{
+   return counts_[ VariantIndex<T,Shape>::value ];
+}
+
+BoundingBox AggregatedShapes::bounds() const
+{
+   repair();
+   return tree_.empty() ? BoundingBox{} : tree_[1];
+}
+
+void AggregatedShapes::add( Shape const& shape )
+{
+   area_ += std::visit( Area{}, shape );
+   ++updates_;
+   ++counts_[shape.index()];
+}
+
+void AggregatedShapes::remove( Shape const& shape )
+{
+   area_ -= std::visit( Area{}, shape );
+   ++updates_;
+   --counts_[shape.index()];
+}
+
+void AggregatedShapes::refreshArea()
+{
+   // Every update of the running sum adds a rounding error. Recomputing the total area after as
+   // many updates as there are shapes keeps the error in the order of the error of a full pass
+   // (amortized O(1) per update).
+   if( updates_ < std::max( shapes_.size(), minUpdates ) ) return;
+
+   area_ = 0.0;
+   for( auto const& shape : shapes_ ) {
+      area_ += std::visit( Area{}, shape );
+   }
+   updates_ = 0U;
+}
+
+void AggregatedShapes::grow()
+{
+   // Since the leaves are always up to date and the capacity is doubled, the tree is simply
+   // rebuilt from its leaves (amortized O(1) per insertion).
+   dirty_.clear();
+   rebuild_ = false;
+
+   std::size_t const capacity = std::max<std::size_t>( 2U*capacity_, 1U );
+   std::vector<BoundingBox> tree( 2U*capacity );
+
+   std::copy_n( tree_.begin()+capacity_, shapes_.size(), tree.begin()+capacity );
+   build( tree, capacity );
+
+   capacity_ = capacity;
+   tree_ = std::move( tree );
+}
+
+void AggregatedShapes::setLeaf( std::size_t index, BoundingBox const& box )
+{
+   tree_[capacity_+index] = box;
+
+   // Without queries, the dirty nodes are limited by the number of leaves (i.e. O(n) memory)
+   if( rebuild_ ) return;
+
+   if( dirty_.size() == capacity_ ) {
+      dirty_.clear();
+      rebuild_ = true;
+   }
+   else {
+      dirty_.push_back( capacity_+index );
+   }
+}
+
+void AggregatedShapes::repair() const
+{
+   if( rebuild_ ) {
+      build( tree_, capacity_ );
+      rebuild_ = false;
+      return;
+   }
+
+   // Repairing level by level ensures that every inner node is recomputed at most once, even if
+   // many edits touched the same subtree.
+   while( !dirty_.empty() )
+   {
+      std::ranges::sort( dirty_ );
+      auto const duplicates = std::ranges::unique( dirty_ );
+      dirty_.erase( duplicates.begin(), duplicates.end() );
+
+      if( dirty_.front() == 1U ) {
+         dirty_.clear();
+         break;
+      }
+
+      for( auto& node : dirty_ ) {
+         node /= 2U;
+         tree_[node] = merge( tree_[2U*node], tree_[2U*node+1U] );
+      }
+   }
+}
+
+void AggregatedShapes::build( std::vector<BoundingBox>& tree, std::size_t capacity )
+{
+   for( std::size_t i=capacity-1U; i>0U; --i ) {
+      tree[i] = merge( tree[2U*i], tree[2U*i+1U] );
+   }
+}
+
+
+//---- <Random.h> ---------------------------------------------------------------------------------
+
+//#include <Shapes.h>
+#include <random>
+
+Shape createShape( std::mt19937& rng )
+{
+   std::uniform_real_distribution<double> coordinates{ -100.0, 100.0 };
+   std::uniform_real_distribution<double> sizes{ 0.1, 1.0 };
+   std::bernoulli_distribution is_circle{ 0.5 };
+
+   Point const center{ coordinates(rng), coordinates(rng) };
+
+   if( is_circle(rng) ) {
+      return Circle{ sizes(rng), center };
+   }
+   else {
+      return Square{ sizes(rng), center };
+   }
+}
+
+Shapes createShapes( std::size_t N, std::mt19937& rng )
+{
+   Shapes shapes{};
+   shapes.reserve( N );
+
+   for( std::size_t i=0U; i<N; ++i ) {
+      shapes.push_back( createShape( rng ) );
+   }
+
+   return shapes;
+}
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+//#include <AggregatedShapes.h>
+//#include <Random.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+double totalArea( Shapes const& shapes )
+{
+   return std::transform_reduce( begin(shapes), end(shapes), 0.0, std::plus<>{}
+                               , []( Shape const& shape ){ return std::visit( Area{}, shape ); } );
+}
+
+BoundingBox bounds( Shapes const& shapes )
+{
+   return std::transform_reduce( begin(shapes), end(shapes), BoundingBox{}
+                               , []( BoundingBox const& lhs, BoundingBox const& rhs ){ return merge( lhs, rhs ); }
+                               , []( Shape const& shape ){ return std::visit( ComputeBoundingBox{}, shape ); } );
+}
+
+bool isClose( double a, double b )
+{
+   return std::abs( a-b ) <= 1E-6 * ( 1.0 + std::abs(a) );
+}
+
+bool operator==( BoundingBox const& lhs, BoundingBox const& rhs )
+{
+   return lhs.min.x == rhs.min.x && lhs.min.y == rhs.min.y &&
+          lhs.max.x == rhs.max.x && lhs.max.y == rhs.max.y;
+}
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+int main()
+{
+   {
+      AggregatedShapes shapes{};
+
+      shapes.insert( Circle{ 2.3 } );
+      shapes.insert( Square{ 1.2, Point{ 5.0, 1.0 } } );
+      shapes.insert( Circle{ 4.1, Point{ -3.0, 2.0 } } );
+
+      shapes.modify( 0U, Square{ 2.0 } );
+      shapes.erase( 1U );
+
+      auto const box = shapes.bounds();
+
+      std::cout << "\n Total area = " << shapes.totalArea()
+                << "\n Circles    = " << shapes.count<Circle>()
+                << "\n Squares    = " << shapes.count<Square>()
+                << "\n Bounds     = [" << box.min.x << "," << box.min.y << "] x ["
+                                      << box.max.x << "," << box.max.y << "]\n";
+   }
+
+   // Correctness check against full passes over all shapes. The bounds are queried after every
+   // edit in the first half and only rarely in the second half (i.e. the tree is rebuilt).
+   {
+      constexpr std::size_t edits = 20000U;
+
+      std::mt19937 mt{ 42 };
+      AggregatedShapes shapes{ createShapes( 1000U, mt ) };
+      std::size_t area_errors{};
+      std::size_t bounds_errors{};
+
+      for( std::size_t edit=0U; edit<edits; ++edit )
+      {
+         std::size_t const index = mt() % shapes.size();
+
+         switch( edit % 3U ) {
+            case 0U: shapes.insert( createShape( mt ) ); break;
+            case 1U: shapes.erase( index ); break;
+            case 2U: shapes.modify( index, createShape( mt ) ); break;
+         }
+
+         if( !isClose( shapes.totalArea(), totalArea( shapes.shapes() ) ) ) {
+            ++area_errors;
+         }
+         bool const query = edit < edits/2U || edit % 5000U == 4999U;
+         if( query && !( shapes.bounds() == bounds( shapes.shapes() ) ) ) {
+            ++bounds_errors;
+         }
+      }
+
+      std::cout << "\n Check of " << edits << " edits: " << area_errors << " area error(s), "
+                << bounds_errors << " bounds error(s)\n";
+
+      if( area_errors != 0U || bounds_errors != 0U ) {
+         std::cerr << "\n ERROR: The aggregates differ from the full passes\n";
+         return EXIT_FAILURE;
+      }
+   }
+
+   // Runtime comparison: one query after every edit
+   {
+      constexpr std::size_t N = 1000000U;
+      constexpr std::size_t edits = 100U;
+
+      std::random_device rd{};
+      std::mt19937 mt{ rd() };
+
+      Shapes const initial{ createShapes( N, mt ) };
+      Shapes edited{ createShape( mt ) };
+      for( std::size_t i=1U; i<edits; ++i ) {
+         edited.push_back( createShape( mt ) );
+      }
+
+      Shapes plain{ initial };
+      AggregatedShapes aggregated{ initial };
+      double checksum_plain{};
+      double checksum_aggregated{};
+
+      double const seconds_plain = measure( [&]{
+         for( std::size_t i=0U; i<edits; ++i ) {
+            plain[i*97U] = edited[i];
+            checksum_plain += totalArea( plain ) + bounds( plain ).max.x;
+         }
+      } );
+
+      double const seconds_aggregated = measure( [&]{
+         for( std::size_t i=0U; i<edits; ++i ) {
+            aggregated.modify( i*97U, edited[i] );
+            checksum_aggregated += aggregated.totalArea() + aggregated.bounds().max.x;
+         }
+      } );
+
+      // The checksums are printed to keep the optimizer from removing the queries
+      std::cout << "\n Runtime of " << edits << " edits+queries on " << N << " shapes:"
+                << "\n  Full pass   : " << seconds_plain << "s (checksum=" << checksum_plain << ")"
+                << "\n  Incremental : " << seconds_aggregated << "s (checksum=" << checksum_aggregated << ")\n\n";
+
+      if( !isClose( checksum_plain, checksum_aggregated ) ) {
+         std::cerr << " ERROR: The checksums of the full pass and the aggregates differ\n";
+         return EXIT_FAILURE;
+      }
+   }
+
+   return EXIT_SUCCESS;
+}
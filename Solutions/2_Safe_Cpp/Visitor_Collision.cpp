@@ -0,0 +1,488 @@
+/**************************************************************************************************
+*
+* \file Visitor_Collision.cpp
+* \brief C++ Training - Programming example for collision detection on value semantics shapes
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Detect all pairs of overlapping shapes in a scene of (potentially) millions of shapes.
+*       Testing every pair of shapes by means of 'std::visit()' is O(n^2) and prohibitively
+*       expensive. Instead, a broad phase (sort-and-sweep along the x-axis on SoA bounding
+*       boxes) reduces the pairs to a few candidates, which are then checked by a narrow phase
+*       based on double-variant visitation.
+*
+* Step 1: Compare the runtime of the brute force and the sort-and-sweep solution.
+*
+* Step 2: Compare the runtime of the sequential and the parallel sweep.
+*
+**************************************************************************************************/
+
+
+//---- <Point.h> ----------------------------------------------------------------------------------
+
+struct Point
+{
+   double x;
+   double y;
+};
+
+
+//---- <Circle.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+class Circle
+{
+ public:
+   explicit Circle( double radius, Point center = {} )
+      : radius_{ radius }
+      , center_{ center }
+   {}
+
+   double radius() const { return radius_; }
+   Point  center() const { return center_; }
+
+ private:
+   double radius_;
+   Point center_;
+};
+
+
+//---- <Square.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+class Square
+{
+ public:
+   explicit Square( double side, Point center = {} )
+      : side_{ side }
+      , center_{ center }
+   {}
+
+   double side() const { return side_; }
+   Point center() const { return center_; }
+
+ private:
+   double side_;
+   Point center_;
+};
+
+
+//---- <Shape.h> ----------------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#include <variant>
+
+using Shape = std::variant<Circle,Square>;
+
+
+//---- <Shapes.h> ---------------------------------------------------------------------------------
+
+//#include <Shape.h>
+#include <vector>
+
+using Shapes = std::vector<Shape>;
+
+
+//==== ARCHITECTURAL BOUNDARY =====================================================================
+
+
+//---- <BoundingBox.h> ----------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Point.h>
+//#include <Square.h>
+
+struct BoundingBox
+{
+   Point min;
+   Point max;
+};
+
+class ComputeBoundingBox
+{
+ public:
+   BoundingBox operator()( Circle const& circle ) const
+   {
+      auto const [x,y] = circle.center();
+      auto const r = circle.radius();
+      return BoundingBox{ { x-r, y-r }, { x+r, y+r } };
+   }
+
+   BoundingBox operator()( Square const& square ) const
+   {
+      auto const [x,y] = square.center();
+      auto const h = square.side() / 2.0;
+      return BoundingBox{ { x-h, y-h }, { x+h, y+h } };
+   }
+};
+
+
+//---- <Intersects.h> -----------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#include <algorithm>
+#include <cmath>
+
+// Narrow phase: exact overlap tests for all combinations of shapes (double-variant visitation).
+// Touching shapes are considered to be colliding.
+class Intersects
+{
+ public:
+   bool operator()( Circle const& lhs, Circle const& rhs ) const
+   {
+      auto const dx = lhs.center().x - rhs.center().x;
+      auto const dy = lhs.center().y - rhs.center().y;
+      auto const r  = lhs.radius() + rhs.radius();
+      return dx*dx + dy*dy <= r*r;
+   }
+
+   bool operator()( Circle const& circle, Square const& square ) const
+   {
+      // Distance between the circle center and the closest point of the square
+      auto const h  = square.side() / 2.0;
+      auto const [cx,cy] = circle.center();
+      auto const [sx,sy] = square.center();
+      auto const dx = cx - std::clamp( cx, sx-h, sx+h );
+      auto const dy = cy - std::clamp( cy, sy-h, sy+h );
+      return dx*dx + dy*dy <= circle.radius() * circle.radius();
+   }
+
+   bool operator()( Square const& square, Circle const& circle ) const
+   {
+      return (*this)( circle, square );
+   }
+
+   bool operator()( Square const& lhs, Square const& rhs ) const
+   {
+      auto const h = ( lhs.side() + rhs.side() ) / 2.0;
+      return std::abs( lhs.center().x - rhs.center().x ) <= h &&
+             std::abs( lhs.center().y - rhs.center().y ) <= h;
+   }
+};
+
+
+//---- <Collisions.h> -----------------------------------------------------------------------------
+
+//#include <Shapes.h>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// A pair of indices into the 'Shapes' container (with 'first < second')
+using Collision  = std::pair<std::size_t,std::size_t>;
+using Collisions = std::vector<Collision>;
+
+Collisions detectCollisionsBruteForce( Shapes const& shapes );
+Collisions detectCollisions( Shapes const& shapes );
+Collisions detectCollisionsParallel( Shapes const& shapes, unsigned int threads = 0U );
+
+
+//---- <Collisions.cpp> ---------------------------------------------------------------------------
+
+//#include <BoundingBox.h>
+//#include <Collisions.h>
+//#include <Intersects.h>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+namespace {
+
+// Bounding boxes of all shapes in structure-of-arrays layout, sorted by 'min_x'. The sweep only
+// touches these contiguous arrays and only visits the shapes themselves for the narrow phase.
+struct SweepAxis
+{
+   std::vector<std::size_t> index;  // Index of the shape in the 'Shapes' container
+   std::vector<double> min_x;
+   std::vector<double> max_x;
+   std::vector<double> min_y;
+   std::vector<double> max_y;
+};
+
+SweepAxis sortBoundingBoxes( Shapes const& shapes )
+{
+   std::vector<BoundingBox> boxes( shapes.size() );
+   std::ranges::transform( shapes, begin(boxes), []( Shape const& shape ){
+      return std::visit( ComputeBoundingBox{}, shape );
+   } );
+
+   SweepAxis axis{};
+   axis.index.resize( shapes.size() );
+   std::iota( begin(axis.index), end(axis.index), std::size_t{0} );
+   std::ranges::sort( axis.index, {}, [&boxes]( std::size_t i ){ return boxes[i].min.x; } );
+
+   axis.min_x.reserve( shapes.size() );
+   axis.max_x.reserve( shapes.size() );
+   axis.min_y.reserve( shapes.size() );
+   axis.max_y.reserve( shapes.size() );
+
+   for( std::size_t i : axis.index ) {
+      axis.min_x.push_back( boxes[i].min.x );
+      axis.max_x.push_back( boxes[i].max.x );
+      axis.min_y.push_back( boxes[i].min.y );
+      axis.max_y.push_back( boxes[i].max.y );
+   }
+
+   return axis;
+}
+
+// Sweeps over the sorted positions [first,last): every box is compared to all following boxes
+// until the first box that starts to the right of its end. Candidates with overlapping y-intervals
+// are passed to the narrow phase.
+void sweep( Shapes const& shapes, SweepAxis const& axis
+          , std::size_t first, std::size_t last, Collisions& collisions )
+{
+   std::size_t const n = axis.index.size();
+
+   for( std::size_t i=first; i<last; ++i )
+   {
+      double const max_x = axis.max_x[i];
+      double const min_y = axis.min_y[i];
+      double const max_y = axis.max_y[i];
+
+      for( std::size_t j=i+1U; j<n && axis.min_x[j] <= max_x; ++j )
+      {
+         if( axis.min_y[j] > max_y || axis.max_y[j] < min_y )
+            continue;
+
+         auto const a = axis.index[i];
+         auto const b = axis.index[j];
+
+         if( std::visit( Intersects{}, shapes[a], shapes[b] ) ) {
+            collisions.emplace_back( std::min(a,b), std::max(a,b) );
+         }
+      }
+   }
+}
+
+} // namespace
+
+
+Collisions detectCollisionsBruteForce( Shapes const& shapes )
+{
+   Collisions collisions{};
+
+   for( std::size_t i=0U; i<shapes.size(); ++i ) {
+      for( std::size_t j=i+1U; j<shapes.size(); ++j ) {
+         if( std::visit( Intersects{}, shapes[i], shapes[j] ) ) {
+            collisions.emplace_back( i, j );
+         }
+      }
+   }
+
+   return collisions;
+}
+
+
+Collisions detectCollisions( Shapes const& shapes )
+{
+   SweepAxis const axis{ sortBoundingBoxes( shapes ) };
+
+   Collisions collisions{};
+   sweep( shapes, axis, 0U, shapes.size(), collisions );
+
+   return collisions;
+}
+
+
+Collisions detectCollisionsParallel( Shapes const& shapes, unsigned int threads )
+{
+   // Below this size the thread startup dominates the sweep
+   constexpr std::size_t minChunkSize = 16384U;
+
+   if( threads == 0U ) {
+      threads = std::max( std::thread::hardware_concurrency(), 1U );
+   }
+
+   std::size_t const n = shapes.size();
+   std::size_t const chunks = std::clamp<std::size_t>( n / minChunkSize, 1U, threads );
+
+   if( chunks == 1U ) {
+      return detectCollisions( shapes );
+   }
+
+   SweepAxis const axis{ sortBoundingBoxes( shapes ) };
+
+   // Every thread sweeps a contiguous range of sorted positions into its own result vector. The
+   // partial results are concatenated in order, which yields the same result as 'detectCollisions()'.
+   std::vector<Collisions> partial( chunks );
+   {
+      std::vector<std::jthread> workers{};
+      workers.reserve( chunks );
+
+      for( std::size_t c=0U; c<chunks; ++c )
+      {
+         std::size_t const first = n *  c     / chunks;
+         std::size_t const last  = n * (c+1U) / chunks;
+         workers.emplace_back( [&,first,last,c]{ sweep( shapes, axis, first, last, partial[c] ); } );
+      }
+   }
+
+   Collisions collisions{};
+   collisions.reserve( std::transform_reduce( begin(partial), end(partial), std::size_t{0}
+                                            , std::plus<>{}, []( Collisions const& p ){ return p.size(); } ) );
+   for( auto const& p : partial ) {
+      collisions.insert( end(collisions), begin(p), end(p) );
+   }
+
+   return collisions;
+}
+
+
+//---- <Random.h> ---------------------------------------------------------------------------------
+
+//#include <Shapes.h>
+#include <random>
+
+Shapes createShapes( std::size_t N, double extent, std::mt19937 rng )
+{
+   std::uniform_real_distribution<double> coordinates{ 0.0, extent };
+   std::uniform_real_distribution<double> sizes{ 0.1, 1.0 };
+   std::bernoulli_distribution is_circle{ 0.5 };
+
+   Shapes shapes{};
+   shapes.reserve( N );
+
+   for( std::size_t i=0U; i<N; ++i )
+   {
+      Point const center{ coordinates(rng), coordinates(rng) };
+
+      if( is_circle(rng) ) {
+         shapes.emplace_back( Circle{ sizes(rng), center } );
+      }
+      else {
+         shapes.emplace_back( Square{ sizes(rng), center } );
+      }
+   }
+
+   return shapes;
+}
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+//#include <Collisions.h>
+//#include <Random.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+int main()
+{
+   {
+      Shapes shapes{};
+
+      shapes.emplace_back( Circle{ 2.3, Point{ 0.0, 0.0 } } );
+      shapes.emplace_back( Square{ 1.2, Point{ 2.5, 1.0 } } );
+      shapes.emplace_back( Circle{ 4.1, Point{ 9.0, 0.0 } } );
+      shapes.emplace_back( Square{ 2.0, Point{ 20.0, 20.0 } } );
+
+      for( auto const& [i,j] : detectCollisions( shapes ) ) {
+         std::cout << " Collision between shape " << i << " and shape " << j << '\n';
+      }
+   }
+
+   // Correctness check of the sequential sweep against the brute force solution, and of the
+   // parallel sweep against the sequential sweep. The parallel check requires several chunks,
+   // i.e. more than 2*16384 shapes and an explicit number of threads.
+   {
+      std::mt19937 mt{ 42 };
+      Shapes const shapes{ createShapes( 5000U, 100.0, mt ) };
+      Shapes const many_shapes{ createShapes( 100000U, 1000.0, mt ) };
+
+      auto reference = detectCollisionsBruteForce( shapes );
+      auto sequential = detectCollisions( shapes );
+
+      std::ranges::sort( reference );
+      std::ranges::sort( sequential );
+
+      if( sequential != reference ) {
+         std::cerr << " Sequential sweep differs from the brute force solution\n";
+         return EXIT_FAILURE;
+      }
+
+      for( unsigned int threads : { 2U, 4U, 7U } )
+      {
+         if( detectCollisionsParallel( many_shapes, threads ) != detectCollisions( many_shapes ) ) {
+            std::cerr << " Parallel sweep (" << threads << " threads) differs from the sequential sweep\n";
+            return EXIT_FAILURE;
+         }
+      }
+   }
+
+   // Runtime comparison of the brute force and the sort-and-sweep solution. Due to the O(n^2)
+   // complexity of the brute force solution, the scene is limited to a few thousand shapes.
+   {
+      constexpr std::size_t N = 10000U;
+
+      std::random_device rd{};
+      std::mt19937 mt{ rd() };
+
+      Shapes const shapes{ createShapes( N, 700.0, mt ) };
+
+      Collisions brute_force{};
+      Collisions sequential{};
+
+      double const seconds_brute_force =
+         measure( [&]{ brute_force = detectCollisionsBruteForce( shapes ); } );
+      double const seconds_sequential = measure( [&]{ sequential = detectCollisions( shapes ); } );
+
+      std::ranges::sort( brute_force );
+      std::ranges::sort( sequential );
+
+      if( sequential != brute_force ) {
+         std::cerr << " Sequential sweep differs from the brute force solution\n";
+         return EXIT_FAILURE;
+      }
+
+      std::cout << "\n Shapes        : " << N
+                << "\n Collisions    : " << sequential.size()
+                << "\n Brute force   : " << seconds_brute_force << "s"
+                << "\n Sequential    : " << seconds_sequential << "s\n";
+   }
+
+   // Runtime comparison of the sequential and the parallel sweep
+   {
+      constexpr std::size_t N = 1000000U;
+
+      std::random_device rd{};
+      std::mt19937 mt{ rd() };
+
+      Shapes const shapes{ createShapes( N, 10000.0, mt ) };
+
+      Collisions sequential{};
+      Collisions parallel{};
+
+      double const seconds_sequential = measure( [&]{ sequential = detectCollisions( shapes ); } );
+      double const seconds_parallel = measure( [&]{ parallel = detectCollisionsParallel( shapes ); } );
+
+      if( sequential != parallel ) {
+         std::cerr << " Parallel sweep differs from the sequential sweep\n";
+         return EXIT_FAILURE;
+      }
+
+      std::cout << "\n Shapes        : " << N
+                << "\n Collisions    : " << sequential.size()
+                << "\n Sequential    : " << seconds_sequential << "s"
+                << "\n Parallel      : " << seconds_parallel << "s\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,336 @@
+/**************************************************************************************************
+*
+* \file Visitor_Compact.cpp
+* \brief C++ Training - Programming example for a compact representation of value semantics shapes
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Reduce the memory footprint of a scene of shapes. 'std::variant<Circle,Square>' with
+*       double precision requires 32 bytes per shape. For a viewer single precision is good
+*       enough, which is why the shapes are generic over the scalar type:
+*        - 'Shape<double>' requires 32 bytes per shape (as before)
+*        - 'Shape<float>' requires 16 bytes per shape
+*        - 'PackedShape<float>' requires 12 bytes per shape, since the discriminator is stored
+*          in the sign bit of the (non-negative) size
+*
+* Step 1: Compare the runtime of computing the total area of all shapes for all representations.
+*
+**************************************************************************************************/
+
+
+//---- <Point.h> ----------------------------------------------------------------------------------
+
+#include <concepts>
+
+template< std::floating_point T >
+struct Point
+{
+   T x;
+   T y;
+};
+
+
+//---- <Circle.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+template< std::floating_point T >
+class Circle
+{
+ public:
+   using value_type = T;
+
+   explicit Circle( T radius, Point<T> center = {} )
+      : radius_{ radius }
+      , center_{ center }
+   {}
+
+   T        radius() const { return radius_; }
+   Point<T> center() const { return center_; }
+
+ private:
+   T radius_;
+   Point<T> center_;
+};
+
+
+//---- <Square.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+template< std::floating_point T >
+class Square
+{
+ public:
+   using value_type = T;
+
+   explicit Square( T side, Point<T> center = {} )
+      : side_{ side }
+      , center_{ center }
+   {}
+
+   T        side() const { return side_; }
+   Point<T> center() const { return center_; }
+
+ private:
+   T side_;
+   Point<T> center_;
+};
+
+
+//---- <Shape.h> ----------------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#include <variant>
+
+template< std::floating_point T >
+using Shape = std::variant<Circle<T>,Square<T>>;
+
+
+//---- <PackedShape.h> ----------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#include <cassert>
+#include <cmath>
+
+// Packed alternative to 'Shape<T>': since the size of a shape (radius or side) is non-negative,
+// the sign bit of the size is used as discriminator (positive: circle, negative: square). This
+// saves the separate (and padded) index of 'std::variant'.
+template< std::floating_point T >
+class PackedShape
+{
+ public:
+   PackedShape( Circle<T> const& circle )
+      : size_{ circle.radius() }
+      , center_{ circle.center() }
+   {
+      assert( !std::signbit( circle.radius() ) );
+   }
+
+   PackedShape( Square<T> const& square )
+      : size_{ -square.side() }
+      , center_{ square.center() }
+   {
+      assert( !std::signbit( square.side() ) );
+   }
+
+   bool isCircle() const { return !std::signbit( size_ ); }
+   bool isSquare() const { return std::signbit( size_ ); }
+
+   T        size()   const { return std::abs( size_ ); }  // Radius or side
+   Point<T> center() const { return center_; }
+
+ private:
+   T size_;
+   Point<T> center_;
+};
+
+// 'std::visit()'-like dispatch: the packed shape is unpacked and passed to the visitor
+template< typename Visitor, std::floating_point T >
+decltype(auto) visit( Visitor&& visitor, PackedShape<T> const& shape )
+{
+   if( shape.isCircle() ) {
+      return std::forward<Visitor>(visitor)( Circle<T>{ shape.size(), shape.center() } );
+   }
+   else {
+      return std::forward<Visitor>(visitor)( Square<T>{ shape.size(), shape.center() } );
+   }
+}
+
+static_assert( sizeof(Shape<double>) == 32U );
+static_assert( sizeof(Shape<float>) == 16U );
+static_assert( sizeof(PackedShape<double>) == 24U );
+static_assert( sizeof(PackedShape<float>) == 12U );
+
+
+//---- <Shapes.h> ---------------------------------------------------------------------------------
+
+//#include <PackedShape.h>
+//#include <Shape.h>
+#include <vector>
+
+template< std::floating_point T >
+using Shapes = std::vector<Shape<T>>;
+
+template< std::floating_point T >
+using PackedShapes = std::vector<PackedShape<T>>;
+
+
+//==== ARCHITECTURAL BOUNDARY =====================================================================
+
+
+//---- <Area.h> -----------------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#include <numbers>
+
+class Area
+{
+ public:
+   template< typename T >
+   T operator()( Circle<T> const& circle ) const
+   {
+      return circle.radius() * circle.radius() * std::numbers::pi_v<T>;
+   }
+
+   template< typename T >
+   T operator()( Square<T> const& square ) const
+   {
+      return square.side() * square.side();
+   }
+};
+
+
+//---- <TotalArea.h> ------------------------------------------------------------------------------
+
+//#include <Area.h>
+//#include <Shapes.h>
+
+template< std::floating_point T >
+T totalArea( Shapes<T> const& shapes )
+{
+   T area{};
+
+   for( auto const& shape : shapes ) {
+      area += std::visit( Area{}, shape );
+   }
+
+   return area;
+}
+
+template< std::floating_point T >
+T totalArea( PackedShapes<T> const& shapes )
+{
+   T area{};
+
+   for( auto const& shape : shapes ) {
+      area += visit( Area{}, shape );
+   }
+
+   return area;
+}
+
+
+//---- <Random.h> ---------------------------------------------------------------------------------
+
+//#include <Shapes.h>
+#include <cstddef>
+#include <random>
+
+template< std::floating_point T >
+Shapes<T> createShapes( std::size_t N, std::mt19937 rng )
+{
+   std::uniform_real_distribution<T> coordinates{ T{-100}, T{100} };
+   std::uniform_real_distribution<T> sizes{ T{0.1}, T{1} };
+   std::bernoulli_distribution is_circle{ 0.5 };
+
+   Shapes<T> shapes{};
+   shapes.reserve( N );
+
+   for( std::size_t i=0U; i<N; ++i )
+   {
+      Point<T> const center{ coordinates(rng), coordinates(rng) };
+
+      if( is_circle(rng) ) {
+         shapes.emplace_back( Circle<T>{ sizes(rng), center } );
+      }
+      else {
+         shapes.emplace_back( Square<T>{ sizes(rng), center } );
+      }
+   }
+
+   return shapes;
+}
+
+template< std::floating_point T >
+PackedShapes<T> pack( Shapes<T> const& shapes )
+{
+   PackedShapes<T> packed{};
+   packed.reserve( shapes.size() );
+
+   for( auto const& shape : shapes ) {
+      packed.push_back( std::visit( []( auto const& s ){ return PackedShape<T>{ s }; }, shape ) );
+   }
+
+   return packed;
+}
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+//#include <Random.h>
+//#include <Shapes.h>
+//#include <TotalArea.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+int main()
+{
+   {
+      PackedShapes<float> shapes{};
+
+      shapes.emplace_back( Circle<float>{ 2.3F } );
+      shapes.emplace_back( Square<float>{ 1.2F } );
+      shapes.emplace_back( Square<float>{ 0.0F } );
+      shapes.emplace_back( Circle<float>{ 4.1F } );
+
+      for( auto const& shape : shapes ) {
+         std::cout << ( shape.isCircle() ? " circle" : " square" ) << ": size=" << shape.size() << '\n';
+      }
+   }
+
+   {
+      constexpr std::size_t N = 1000000U;
+      constexpr std::size_t repetitions = 20U;
+
+      std::random_device rd{};
+      auto const seed = rd();
+
+      Shapes<double> const shapes_double{ createShapes<double>( N, std::mt19937{ seed } ) };
+      Shapes<float> const shapes_float{ createShapes<float>( N, std::mt19937{ seed } ) };
+      PackedShapes<float> const shapes_packed{ pack( shapes_float ) };
+
+      double area_double{};
+      float area_float{};
+      float area_packed{};
+
+      double const seconds_double = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) area_double += totalArea( shapes_double );
+      } ) / repetitions;
+
+      double const seconds_float = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) area_float += totalArea( shapes_float );
+      } ) / repetitions;
+
+      double const seconds_packed = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) area_packed += totalArea( shapes_packed );
+      } ) / repetitions;
+
+      std::cout << "\n Total area of " << N << " shapes:"
+                << "\n  Shape<double>      (" << sizeof(Shape<double>) << " bytes): "
+                << seconds_double*1E3 << "ms (area=" << area_double/repetitions << ")"
+                << "\n  Shape<float>       (" << sizeof(Shape<float>) << " bytes): "
+                << seconds_float*1E3 << "ms (area=" << area_float/repetitions << ")"
+                << "\n  PackedShape<float> (" << sizeof(PackedShape<float>) << " bytes): "
+                << seconds_packed*1E3 << "ms (area=" << area_packed/repetitions << ")\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,499 @@
+/**************************************************************************************************
+*
+* \file Visitor_Dedup.cpp
+* \brief C++ Training - Programming example for the deduplication of value semantics shapes
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Many scenes contain a lot of identical shapes (same type, same size and same center).
+*       The 'DeduplicatedShapes' class stores every unique shape only once (content-addressed
+*       by a hash of the type and the bit patterns of all data members) and keeps a reference
+*       per inserted shape. The serialization emits the dictionary of unique shapes, followed
+*       by the references.
+*
+* Step 1: Compare the size of the serialized scene with and without deduplication.
+*
+* Step 2: Compare the runtime of building the scene with and without deduplication.
+*
+**************************************************************************************************/
+
+
+//---- <FastSerialization.h> (external) -----------------------------------------------------------
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+// ... and many more serialization-related headers
+
+namespace fs {
+
+class Serializer
+{
+ public:
+   std::string to_string() const
+   {
+      return std::string( buffer_.data(), buffer_.size() );
+   }
+
+   std::size_t size() const { return buffer_.size(); }
+
+ private:
+   std::vector<char> buffer_;
+
+   template< typename T, typename = std::enable_if_t< std::is_arithmetic_v<T> > >
+   //   requires std::is_arithmetic_v<T>  // C++20 concept
+   friend Serializer& operator<<( Serializer& serializer, T value )
+   {
+      size_t const old_size = serializer.buffer_.size();
+      serializer.buffer_.resize( old_size + sizeof(T) );
+
+      auto* data = serializer.buffer_.data() + old_size;
+      ::new (data) T{value};
+
+      return serializer;
+   }
+};
+
+} // namespace fs
+
+
+//---- <Point.h> ----------------------------------------------------------------------------------
+
+struct Point
+{
+   double x;
+   double y;
+};
+
+
+//---- <Circle.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+class Circle
+{
+ public:
+   explicit Circle( double radius, Point center = {} )
+      : radius_{ radius }
+      , center_{ center }
+   {}
+
+   double radius() const { return radius_; }
+   Point  center() const { return center_; }
+
+ private:
+   double radius_;
+   Point center_;
+};
+
+
+//---- <Square.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+class Square
+{
+ public:
+   explicit Square( double side, Point center = {} )
+      : side_{ side }
+      , center_{ center }
+   {}
+
+   double side() const { return side_; }
+   Point center() const { return center_; }
+
+ private:
+   double side_;
+   Point center_;
+};
+
+
+//---- <Shape.h> ----------------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#include <variant>
+
+using Shape = std::variant<Circle,Square>;
+
+
+//---- <Shapes.h> ---------------------------------------------------------------------------------
+
+//#include <Shape.h>
+#include <vector>
+
+using Shapes = std::vector<Shape>;
+
+
+//==== ARCHITECTURAL BOUNDARY =====================================================================
+
+
+//---- <ShapeKey.h> -------------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Shape.h>
+//#include <Square.h>
+#include <bit>
+#include <cstdint>
+
+// Content of a shape as raw bit patterns. Two shapes are considered identical if they have the
+// same type and bitwise identical data members (i.e. 0.0 and -0.0 are considered different).
+struct ShapeKey
+{
+   std::uint64_t type;
+   std::uint64_t size;
+   std::uint64_t x;
+   std::uint64_t y;
+
+   bool operator==( ShapeKey const& ) const = default;
+};
+
+class ComputeShapeKey
+{
+ public:
+   ShapeKey operator()( Circle const& circle ) const
+   {
+      return ShapeKey{ 0U, std::bit_cast<std::uint64_t>( circle.radius() )
+                     , std::bit_cast<std::uint64_t>( circle.center().x )
+                     , std::bit_cast<std::uint64_t>( circle.center().y ) };
+   }
+
+   ShapeKey operator()( Square const& square ) const
+   {
+      return ShapeKey{ 1U, std::bit_cast<std::uint64_t>( square.side() )
+                     , std::bit_cast<std::uint64_t>( square.center().x )
+                     , std::bit_cast<std::uint64_t>( square.center().y ) };
+   }
+};
+
+// Cheap multiply-xorshift mixing of the four words of the key
+inline std::uint64_t hash( ShapeKey const& key )
+{
+   constexpr std::uint64_t k = 0x9E3779B97F4A7C15ULL;
+
+   auto const mix = []( std::uint64_t h, std::uint64_t v ){
+      h = ( h ^ v ) * k;
+      return h ^ ( h >> 32 );
+   };
+
+   return mix( mix( mix( mix( k, key.type ), key.size ), key.x ), key.y );
+}
+
+
+//---- <DeduplicatedShapes.h> ---------------------------------------------------------------------
+
+//#include <ShapeKey.h>
+//#include <Shapes.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Shape container that stores every unique shape once. Every inserted shape is represented by
+// a reference (index) into the dictionary of unique shapes.
+class DeduplicatedShapes
+{
+ public:
+   using Reference = std::uint32_t;
+
+   DeduplicatedShapes() = default;
+   explicit DeduplicatedShapes( Shapes const& shapes );
+
+   void reserve( std::size_t n );
+   Reference insert( Shape const& shape );
+
+   Shape const& operator[]( std::size_t index ) const { return unique_[references_[index]]; }
+   std::size_t size() const { return references_.size(); }
+
+   Shapes const& dictionary() const { return unique_; }
+   std::vector<Reference> const& references() const { return references_; }
+
+ private:
+   static constexpr Reference empty = ~Reference{};
+
+   void rehash( std::size_t capacity );
+
+   Shapes unique_{};
+   std::vector<ShapeKey> keys_{};         // Keys of the unique shapes
+   std::vector<Reference> references_{};  // One reference per inserted shape
+
+   // Open addressing hash table (linear probing, power-of-two capacity) of indices into the
+   // dictionary. The hash value is stored alongside to avoid most key comparisons.
+   std::vector<Reference> slots_{};
+   std::vector<std::uint64_t> hashes_{};
+};
+
+
+//---- <DeduplicatedShapes.cpp> -------------------------------------------------------------------
+
+//#include <DeduplicatedShapes.h>
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+DeduplicatedShapes::DeduplicatedShapes( Shapes const& shapes )
+{
+   reserve( shapes.size() );
+
+   for( auto const& shape : shapes ) {
+      insert( shape );
+   }
+}
+
+void DeduplicatedShapes::reserve( std::size_t n )
+{
+   references_.reserve( n );
+
+   // Keeps the load factor of the hash table below 0.5
+   if( 2U*n > slots_.size() ) {
+      rehash( std::bit_ceil( 2U*n ) );
+   }
+}
+
+DeduplicatedShapes::Reference DeduplicatedShapes::insert( Shape const& shape )
+{
+   if( 2U*(unique_.size()+1U) > slots_.size() ) {
+      rehash( std::max<std::size_t>( 2U*slots_.size(), 16U ) );
+   }
+
+   ShapeKey const key{ std::visit( ComputeShapeKey{}, shape ) };
+   std::uint64_t const h{ hash( key ) };
+   std::size_t const mask{ slots_.size() - 1U };
+
+   std::size_t slot{ h & mask };
+   while( slots_[slot] != empty )
+   {
+      if( hashes_[slot] == h && keys_[slots_[slot]] == key ) {
+         references_.push_back( slots_[slot] );
+         return slots_[slot];
+      }
+      slot = ( slot + 1U ) & mask;
+   }
+
+   auto const reference = static_cast<Reference>( unique_.size() );
+   slots_[slot] = reference;
+   hashes_[slot] = h;
+   unique_.push_back( shape );
+   keys_.push_back( key );
+   references_.push_back( reference );
+
+   return reference;
+}
+
+void DeduplicatedShapes::rehash( std::size_t capacity )
+{
+   std::vector<Reference> slots( capacity, empty );
+   std::vector<std::uint64_t> hashes( capacity );
+   std::size_t const mask{ capacity - 1U };
+
+   for( std::size_t i=0U; i<slots_.size(); ++i )
+   {
+      if( slots_[i] == empty )
+         continue;
+
+      std::size_t slot{ hashes_[i] & mask };
+      while( slots[slot] != empty ) {
+         slot = ( slot + 1U ) & mask;
+      }
+      slots[slot] = slots_[i];
+      hashes[slot] = hashes_[i];
+   }
+
+   slots_ = std::move( slots );
+   hashes_ = std::move( hashes );
+}
+
+
+//---- <FSSerializer.h> ---------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+//#include <FastSerialization.h>
+#include <cstdint>
+#include <typeinfo>
+
+class FSSerializer
+{
+ public:
+   void operator()( Circle const& circle )
+   {
+      serializer_ << typeid(Circle).hash_code() << circle.radius()
+                  << circle.center().x << circle.center().y;
+   }
+
+   void operator()( Square const& square )
+   {
+      serializer_ << typeid(Square).hash_code() << square.side()
+                  << square.center().x << square.center().y;
+   }
+
+   void count( std::uint64_t n ) { serializer_ << n; }
+   void reference( std::uint32_t index ) { serializer_ << index; }
+
+   std::string to_string() const { return serializer_.to_string(); }
+   std::size_t size() const { return serializer_.size(); }
+
+ private:
+   fs::Serializer serializer_;
+};
+
+
+//---- <SerializeAllShapes.h> ---------------------------------------------------------------------
+
+//#include <DeduplicatedShapes.h>
+//#include <FSSerializer.h>
+//#include <Shapes.h>
+
+void serializeAllShapes( Shapes const& shapes, FSSerializer& serializer );
+void serializeAllShapes( DeduplicatedShapes const& shapes, FSSerializer& serializer );
+
+
+//---- <SerializeAllShapes.cpp> -------------------------------------------------------------------
+
+//#include <SerializeAllShapes.h>
+
+void serializeAllShapes( Shapes const& shapes, FSSerializer& serializer )
+{
+   for( auto const& shape : shapes )
+   {
+      std::visit( serializer, shape );
+   }
+}
+
+void serializeAllShapes( DeduplicatedShapes const& shapes, FSSerializer& serializer )
+{
+   // Dictionary of unique shapes ...
+   serializer.count( shapes.dictionary().size() );
+   serializeAllShapes( shapes.dictionary(), serializer );
+
+   // ... followed by one reference per shape
+   serializer.count( shapes.references().size() );
+   for( auto const reference : shapes.references() ) {
+      serializer.reference( reference );
+   }
+}
+
+
+//---- <Random.h> ---------------------------------------------------------------------------------
+
+//#include <Shapes.h>
+#include <random>
+
+// Creates a scene of 'N' shapes based on 'M' different shapes
+Shapes createShapes( std::size_t N, std::size_t M, std::mt19937 rng )
+{
+   std::uniform_real_distribution<double> coordinates{ -100.0, 100.0 };
+   std::uniform_real_distribution<double> sizes{ 0.1, 1.0 };
+   std::bernoulli_distribution is_circle{ 0.5 };
+
+   Shapes prototypes{};
+   prototypes.reserve( M );
+
+   for( std::size_t i=0U; i<M; ++i )
+   {
+      Point const center{ coordinates(rng), coordinates(rng) };
+
+      if( is_circle(rng) ) {
+         prototypes.emplace_back( Circle{ sizes(rng), center } );
+      }
+      else {
+         prototypes.emplace_back( Square{ sizes(rng), center } );
+      }
+   }
+
+   std::uniform_int_distribution<std::size_t> pick{ 0U, M-1U };
+
+   Shapes shapes{};
+   shapes.reserve( N );
+
+   for( std::size_t i=0U; i<N; ++i ) {
+      shapes.push_back( prototypes[pick(rng)] );
+   }
+
+   return shapes;
+}
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+//#include <DeduplicatedShapes.h>
+//#include <Random.h>
+//#include <SerializeAllShapes.h>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+int main()
+{
+   {
+      DeduplicatedShapes shapes{};
+
+      shapes.insert( Circle{ 2.3 } );
+      shapes.insert( Square{ 1.2 } );
+      shapes.insert( Circle{ 2.3 } );
+      shapes.insert( Circle{ 4.1 } );
+      shapes.insert( Square{ 1.2 } );
+
+      std::cout << "\n Shapes        : " << shapes.size()
+                << "\n Unique shapes : " << shapes.dictionary().size()
+                << "\n References    :";
+      for( auto const reference : shapes.references() ) {
+         std::cout << ' ' << reference;
+      }
+      std::cout << '\n';
+   }
+
+   {
+      constexpr std::size_t N = 1000000U;
+      constexpr std::size_t M = 1000U;
+
+      std::random_device rd{};
+      std::mt19937 mt{ rd() };
+
+      Shapes const scene{ createShapes( N, M, mt ) };
+
+      Shapes shapes{};
+      DeduplicatedShapes deduplicated{};
+
+      double const seconds_plain = measure( [&]{
+         shapes.reserve( N );
+         for( auto const& shape : scene ) shapes.push_back( shape );
+      } );
+
+      double const seconds_dedup = measure( [&]{
+         deduplicated.reserve( N );
+         for( auto const& shape : scene ) deduplicated.insert( shape );
+      } );
+
+      for( std::size_t i=0U; i<N; ++i ) {
+         assert( std::visit( ComputeShapeKey{}, deduplicated[i] ) == std::visit( ComputeShapeKey{}, scene[i] ) );
+      }
+
+      FSSerializer serializer_plain{};
+      FSSerializer serializer_dedup{};
+      serializeAllShapes( shapes, serializer_plain );
+      serializeAllShapes( deduplicated, serializer_dedup );
+
+      std::cout << "\n Shapes        : " << N
+                << "\n Unique shapes : " << deduplicated.dictionary().size()
+                << "\n Building      : " << seconds_plain << "s (plain), " << seconds_dedup << "s (deduplicated)"
+                << "\n Serialized    : " << serializer_plain.size() << " bytes (plain), "
+                << serializer_dedup.size() << " bytes (deduplicated)\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,543 @@
+/**************************************************************************************************
+*
+* \file Visitor_Transform.cpp
+* \brief C++ Training - Programming example for bulk transformations of value semantics shapes
+*
+* Copyright (C) 2015-2025 Klaus Iglberger - All Rights Reserved
+*
+* This file is part of the C++ training by Klaus Iglberger. The file may only be used in the
+* context of the C++ training or with explicit agreement by Klaus Iglberger.
+*
+* Task: Apply the same geometric transformation (translation, uniform scaling and rotation) to
+*       all shapes of a scene. The transformation can be applied either to a 'Shapes' container
+*       (via 'std::visit()') or to a structure-of-arrays based 'ShapeStore', whose tight loops
+*       over contiguous arrays are easily vectorized by the compiler (e.g. '-O3').
+*
+* Step 1: Compare the runtime per million shapes of both approaches.
+*
+* Step 2: Compare the runtime of the in-place and the out-of-place transformation.
+*
+**************************************************************************************************/
+
+
+//---- <Point.h> ----------------------------------------------------------------------------------
+
+struct Point
+{
+   double x;
+   double y;
+};
+
+
+//---- <Circle.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+class Circle
+{
+ public:
+   explicit Circle( double radius, Point center = {} )
+      : radius_{ radius }
+      , center_{ center }
+   {}
+
+   double radius() const { return radius_; }
+   Point  center() const { return center_; }
+
+ private:
+   double radius_;
+   Point center_;
+};
+
+
+//---- <Square.h> ---------------------------------------------------------------------------------
+
+//#include <Point.h>
+
+class Square
+{
+ public:
+   explicit Square( double side, Point center = {} )
+      : side_{ side }
+      , center_{ center }
+   {}
+
+   double side() const { return side_; }
+   Point center() const { return center_; }
+
+ private:
+   double side_;
+   Point center_;
+};
+
+
+//---- <Shape.h> ----------------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Square.h>
+#include <variant>
+
+using Shape = std::variant<Circle,Square>;
+
+
+//---- <Shapes.h> ---------------------------------------------------------------------------------
+
+//#include <Shape.h>
+#include <vector>
+
+using Shapes = std::vector<Shape>;
+
+
+//==== ARCHITECTURAL BOUNDARY =====================================================================
+
+
+//---- <Transform.h> ------------------------------------------------------------------------------
+
+//#include <Point.h>
+#include <cmath>
+
+// Similarity transformation 'p' = scale * R(angle) * p + translation'. Since shapes don't have an
+// orientation, a rotation only affects the center of a shape (squares remain axis-aligned). The
+// scaling factor is applied to both the centers and the sizes of the shapes.
+class Transform
+{
+ public:
+   Transform() = default;
+
+   static Transform translation( double dx, double dy ) { return Transform{ 1.0, 0.0, dx, dy }; }
+   static Transform scaling( double s ) { return Transform{ s, 0.0, 0.0, 0.0 }; }
+   static Transform rotation( double angle ) { return Transform{ std::cos(angle), std::sin(angle), 0.0, 0.0 }; }
+
+   // Concatenation: first 'rhs', then 'lhs'
+   friend Transform operator*( Transform const& lhs, Transform const& rhs )
+   {
+      return Transform{ lhs.a_*rhs.a_ - lhs.b_*rhs.b_
+                      , lhs.a_*rhs.b_ + lhs.b_*rhs.a_
+                      , lhs.a_*rhs.tx_ - lhs.b_*rhs.ty_ + lhs.tx_
+                      , lhs.b_*rhs.tx_ + lhs.a_*rhs.ty_ + lhs.ty_ };
+   }
+
+   Point apply( Point p ) const
+   {
+      return Point{ a_*p.x - b_*p.y + tx_, b_*p.x + a_*p.y + ty_ };
+   }
+
+   double scale() const { return std::hypot( a_, b_ ); }
+
+   double a()  const { return a_;  }  // scale * cos(angle)
+   double b()  const { return b_;  }  // scale * sin(angle)
+   double tx() const { return tx_; }
+   double ty() const { return ty_; }
+
+ private:
+   Transform( double a, double b, double tx, double ty )
+      : a_{ a }, b_{ b }, tx_{ tx }, ty_{ ty }
+   {}
+
+   double a_{ 1.0 };
+   double b_{ 0.0 };
+   double tx_{ 0.0 };
+   double ty_{ 0.0 };
+};
+
+
+//---- <TransformShape.h> -------------------------------------------------------------------------
+
+//#include <Circle.h>
+//#include <Shape.h>
+//#include <Square.h>
+//#include <Transform.h>
+
+class TransformShape
+{
+ public:
+   explicit TransformShape( Transform const& transform )
+      : transform_{ transform }
+      , scale_{ transform.scale() }
+   {}
+
+   Shape operator()( Circle const& circle ) const
+   {
+      return Circle{ circle.radius() * scale_, transform_.apply( circle.center() ) };
+   }
+
+   Shape operator()( Square const& square ) const
+   {
+      return Square{ square.side() * scale_, transform_.apply( square.center() ) };
+   }
+
+ private:
+   Transform transform_;
+   double scale_;
+};
+
+
+//---- <TransformAllShapes.h> ---------------------------------------------------------------------
+
+//#include <Shapes.h>
+//#include <Transform.h>
+
+void transformAllShapes( Shapes& shapes, Transform const& transform );
+Shapes transformAllShapes( Shapes const& shapes, Transform const& transform );
+
+
+//---- <TransformAllShapes.cpp> -------------------------------------------------------------------
+
+//#include <TransformAllShapes.h>
+//#include <TransformShape.h>
+#include <algorithm>
+
+void transformAllShapes( Shapes& shapes, Transform const& transform )
+{
+   TransformShape const transformer{ transform };
+
+   for( auto& shape : shapes ) {
+      shape = std::visit( transformer, shape );
+   }
+}
+
+Shapes transformAllShapes( Shapes const& shapes, Transform const& transform )
+{
+   TransformShape const transformer{ transform };
+
+   Shapes result{};
+   result.reserve( shapes.size() );
+
+   std::ranges::transform( shapes, std::back_inserter(result), [&]( Shape const& shape ){
+      return std::visit( transformer, shape );
+   } );
+
+   return result;
+}
+
+
+//---- <ShapeStore.h> -----------------------------------------------------------------------------
+
+//#include <Shapes.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays representation of a scene: each attribute of the shapes is stored in a
+// separate contiguous array, which enables vectorized processing of all shapes.
+class ShapeStore
+{
+ public:
+   enum class Kind : std::uint8_t { circle, square };
+
+   ShapeStore() = default;
+   explicit ShapeStore( Shapes const& shapes );
+
+   void add( Circle const& circle );
+   void add( Square const& square );
+
+   Shape shape( std::size_t index ) const;
+   Shapes shapes() const;
+
+   std::size_t size() const { return kind_.size(); }
+   void resize( std::size_t n );
+
+   Kind kind( std::size_t index ) const { return kind_[index]; }
+
+   double*       x()       { return x_.data(); }
+   double const* x() const { return x_.data(); }
+   double*       y()       { return y_.data(); }
+   double const* y() const { return y_.data(); }
+   double*       size_data()       { return size_.data(); }  // Radius or side
+   double const* size_data() const { return size_.data(); }
+   Kind const*   kinds() const { return kind_.data(); }
+   Kind*         kinds()       { return kind_.data(); }
+
+ private:
+   std::vector<Kind> kind_;
+   std::vector<double> x_;
+   std::vector<double> y_;
+   std::vector<double> size_;
+};
+
+
+//---- <ShapeStore.cpp> ---------------------------------------------------------------------------
+
+//#include <ShapeStore.h>
+
+ShapeStore::ShapeStore( Shapes const& shapes )
+{
+   kind_.reserve( shapes.size() );
+   x_.reserve( shapes.size() );
+   y_.reserve( shapes.size() );
+   size_.reserve( shapes.size() );
+
+   for( auto const& shape : shapes ) {
+      std::visit( [this]( auto const& s ){ add( s ); }, shape );
+   }
+}
+
+void ShapeStore::add( Circle const& circle )
+{
+   kind_.push_back( Kind::circle );
+   x_.push_back( circle.center().x );
+   y_.push_back( circle.center().y );
+   size_.push_back( circle.radius() );
+}
+
+void ShapeStore::add( Square const& square )
+{
+   kind_.push_back( Kind::square );
+   x_.push_back( square.center().x );
+   y_.push_back( square.center().y );
+   size_.push_back( square.side() );
+}
+
+Shape ShapeStore::shape( std::size_t index ) const
+{
+   Point const center{ x_[index], y_[index] };
+
+   switch( kind_[index] ) {
+      case Kind::circle:
+         return Circle{ size_[index], center };
+      case Kind::square:
+      default:
+         return Square{ size_[index], center };
+   }
+}
+
+Shapes ShapeStore::shapes() const
+{
+   Shapes shapes{};
+   shapes.reserve( size() );
+
+   for( std::size_t i=0U; i<size(); ++i ) {
+      shapes.push_back( shape(i) );
+   }
+
+   return shapes;
+}
+
+void ShapeStore::resize( std::size_t n )
+{
+   kind_.resize( n );
+   x_.resize( n );
+   y_.resize( n );
+   size_.resize( n );
+}
+
+
+//---- <TransformShapeStore.h> --------------------------------------------------------------------
+
+//#include <ShapeStore.h>
+//#include <Transform.h>
+
+void transformAllShapes( ShapeStore& store, Transform const& transform );
+void transformAllShapes( ShapeStore const& in, ShapeStore& out, Transform const& transform );
+
+
+//---- <TransformShapeStore.cpp> ------------------------------------------------------------------
+
+//#include <TransformShapeStore.h>
+#include <algorithm>
+
+namespace {
+
+// The kernel works on raw pointers; '__restrict' promises that the output arrays don't alias the
+// input arrays, which allows the compiler to vectorize the loops without runtime alias checks.
+void transformKernel( double const* __restrict x_in, double const* __restrict y_in
+                    , double const* __restrict size_in
+                    , double* __restrict x_out, double* __restrict y_out
+                    , double* __restrict size_out
+                    , std::size_t n, Transform const& transform )
+{
+   double const a  = transform.a();
+   double const b  = transform.b();
+   double const tx = transform.tx();
+   double const ty = transform.ty();
+   double const s  = transform.scale();
+
+   for( std::size_t i=0U; i<n; ++i ) {
+      double const x = x_in[i];
+      double const y = y_in[i];
+      x_out[i] = a*x - b*y + tx;
+      y_out[i] = b*x + a*y + ty;
+   }
+
+   for( std::size_t i=0U; i<n; ++i ) {
+      size_out[i] = size_in[i] * s;
+   }
+}
+
+// In-place version: every element is read before it is written. The three arrays are distinct.
+void transformKernel( double* __restrict x, double* __restrict y, double* __restrict size
+                    , std::size_t n, Transform const& transform )
+{
+   double const a  = transform.a();
+   double const b  = transform.b();
+   double const tx = transform.tx();
+   double const ty = transform.ty();
+   double const s  = transform.scale();
+
+   for( std::size_t i=0U; i<n; ++i ) {
+      double const xi = x[i];
+      double const yi = y[i];
+      x[i] = a*xi - b*yi + tx;
+      y[i] = b*xi + a*yi + ty;
+   }
+
+   for( std::size_t i=0U; i<n; ++i ) {
+      size[i] *= s;
+   }
+}
+
+} // namespace
+
+
+void transformAllShapes( ShapeStore& store, Transform const& transform )
+{
+   transformKernel( store.x(), store.y(), store.size_data(), store.size(), transform );
+}
+
+void transformAllShapes( ShapeStore const& in, ShapeStore& out, Transform const& transform )
+{
+   if( &in == &out ) {
+      transformAllShapes( out, transform );
+      return;
+   }
+
+   out.resize( in.size() );
+   std::copy_n( in.kinds(), in.size(), out.kinds() );
+   transformKernel( in.x(), in.y(), in.size_data()
+                  , out.x(), out.y(), out.size_data(), in.size(), transform );
+}
+
+
+//---- <Random.h> ---------------------------------------------------------------------------------
+
+//#include <Shapes.h>
+#include <random>
+
+Shapes createShapes( std::size_t N, std::mt19937 rng )
+{
+   std::uniform_real_distribution<double> coordinates{ -100.0, 100.0 };
+   std::uniform_real_distribution<double> sizes{ 0.1, 1.0 };
+   std::bernoulli_distribution is_circle{ 0.5 };
+
+   Shapes shapes{};
+   shapes.reserve( N );
+
+   for( std::size_t i=0U; i<N; ++i )
+   {
+      Point const center{ coordinates(rng), coordinates(rng) };
+
+      if( is_circle(rng) ) {
+         shapes.emplace_back( Circle{ sizes(rng), center } );
+      }
+      else {
+         shapes.emplace_back( Square{ sizes(rng), center } );
+      }
+   }
+
+   return shapes;
+}
+
+
+//---- <Main.cpp> ---------------------------------------------------------------------------------
+
+//#include <Random.h>
+//#include <ShapeStore.h>
+//#include <TransformAllShapes.h>
+//#include <TransformShapeStore.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numbers>
+
+template< typename Callable >
+double measure( Callable callable )
+{
+   auto const start_time = std::chrono::high_resolution_clock::now();
+   callable();
+   auto const end_time = std::chrono::high_resolution_clock::now();
+   std::chrono::duration<double> const elapsedTime = end_time - start_time;
+   return elapsedTime.count();
+}
+
+bool isClose( ShapeStore const& lhs, ShapeStore const& rhs )
+{
+   auto const close = []( double a, double b ){ return std::abs( a-b ) <= 1E-9 * ( 1.0 + std::abs(a) ); };
+
+   if( lhs.size() != rhs.size() )
+      return false;
+
+   for( std::size_t i=0U; i<lhs.size(); ++i ) {
+      if( lhs.kind(i) != rhs.kind(i) ||
+          !close( lhs.x()[i], rhs.x()[i] ) || !close( lhs.y()[i], rhs.y()[i] ) ||
+          !close( lhs.size_data()[i], rhs.size_data()[i] ) )
+         return false;
+   }
+
+   return true;
+}
+
+int main()
+{
+   auto const transform = Transform::translation( 1.0, -2.0 )
+                        * Transform::rotation( std::numbers::pi / 4.0 )
+                        * Transform::scaling( 2.0 );
+
+   // Correctness check of the SoA transformation against the 'std::visit()' based transformation
+   {
+      std::mt19937 mt{ 42 };
+      Shapes const shapes{ createShapes( 1000U, mt ) };
+
+      ShapeStore const expected{ transformAllShapes( shapes, transform ) };
+
+      ShapeStore store{ shapes };
+      ShapeStore out{};
+      transformAllShapes( store, out, transform );  // Out-of-place
+      transformAllShapes( store, transform );        // In-place
+
+      if( !isClose( out, expected ) ) {
+         std::cerr << "\n ERROR: Out-of-place transformation differs from std::visit()!\n";
+         return EXIT_FAILURE;
+      }
+      if( !isClose( store, expected ) ) {
+         std::cerr << "\n ERROR: In-place transformation differs from std::visit()!\n";
+         return EXIT_FAILURE;
+      }
+      if( !isClose( ShapeStore{ store.shapes() }, expected ) ) {
+         std::cerr << "\n ERROR: Transformed shapes differ after the conversion to Shapes!\n";
+         return EXIT_FAILURE;
+      }
+   }
+
+   // Runtime comparison per million shapes
+   {
+      constexpr std::size_t N = 1000000U;
+      constexpr std::size_t repetitions = 20U;
+
+      std::random_device rd{};
+      std::mt19937 mt{ rd() };
+
+      Shapes shapes{ createShapes( N, mt ) };
+      ShapeStore store{ shapes };
+      ShapeStore out{};
+      out.resize( N );
+
+      double const seconds_visit = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) transformAllShapes( shapes, transform );
+      } ) / repetitions;
+
+      double const seconds_inplace = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) transformAllShapes( store, transform );
+      } ) / repetitions;
+
+      double const seconds_outofplace = measure( [&]{
+         for( std::size_t r=0U; r<repetitions; ++r ) transformAllShapes( store, out, transform );
+      } ) / repetitions;
+
+      std::cout << "\n Runtime per million shapes:"
+                << "\n  Shapes (std::visit)        : " << seconds_visit * 1E3 << "ms"
+                << "\n  ShapeStore (in-place)      : " << seconds_inplace * 1E3 << "ms"
+                << "\n  ShapeStore (out-of-place)  : " << seconds_outofplace * 1E3 << "ms\n\n";
+   }
+
+   return EXIT_SUCCESS;
+}